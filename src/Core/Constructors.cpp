@@ -17,7 +17,7 @@ Constructors::Constructors() {
     price = 0.0f;
 }
 
-string Constructors::getCode() const {  // Add const here
+const string& Constructors::getCode() const {  // Add const here
     return code;
 }
 
@@ -29,7 +29,7 @@ float Constructors::getPrice() const {  // Add const here
     return price;
 }
 
-string Constructors::getTeamName() const {  // Add const here
+const string& Constructors::getTeamName() const {  // Add const here
     return Team_name;
 }
 
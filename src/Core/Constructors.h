@@ -19,10 +19,10 @@ public:
 
     Constructors();
 
-    string getCode() const;           // Add const
+    const string& getCode() const;    // Add const
     int getPoints() const;            // Add const
     float getPrice() const;           // Add const
-    string getTeamName() const;       // Add const
+    const string& getTeamName() const; // Add const
 
     void addpoints(int p);
 };
@@ -9,6 +9,9 @@ Driver::Driver() {
     team = "idk gng";
     points = 0;
     price = 0;
+    avgfinishes = 0;
+    wins = 0;
+    podiums = 0;
 }
 
 Driver::Driver(string Code, string Name, string Team, int Points, float Price, int Finishes, int Wins, int Podiums) {
@@ -22,13 +25,13 @@ Driver::Driver(string Code, string Name, string Team, int Points, float Price, i
     podiums = Podiums;
 }
 
-string Driver::getName() const{
+const string& Driver::getName() const{
     return name;
 }
-string Driver::getCode() const{
+const string& Driver::getCode() const{
     return code;
 }
-string Driver::getTeam() const{
+const string& Driver::getTeam() const{
     return team;
 }
 int Driver::getPoints() const{
@@ -37,6 +40,15 @@ int Driver::getPoints() const{
 float Driver::getPrice() const{
     return price;
 }
+int Driver::getAvgFinishes() const{
+    return avgfinishes;
+}
+int Driver::getWins() const{
+    return wins;
+}
+int Driver::getPodiums() const{
+    return podiums;
+}
 
 void Driver::addpoints(int x) {
     points += x;
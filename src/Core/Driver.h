@@ -22,11 +22,14 @@ public:
     Driver(string Code, string Name, string Team, int Points, float Price, int Finishes, int Wins, int Podiums);
     Driver();
 
-    string getName() const;
-    string getCode() const;
-    string getTeam() const;
+    const string& getName() const;
+    const string& getCode() const;
+    const string& getTeam() const;
     int getPoints() const;
     float getPrice() const;
+    int getAvgFinishes() const;
+    int getWins() const;
+    int getPodiums() const;
 
     void addpoints(int x);
 
@@ -18,7 +18,7 @@ Team::Team() {
 
 
 void Team::addDriver(Driver driver) {
-    Drivers.push_back(driver);
+    Drivers.push_back(move(driver));
     totaldrivers++;
 }
 
@@ -37,16 +37,16 @@ void Team::setConstructor(Constructors Constructor) {
     constructor = Constructor;
 }
 
-float Team::getBudgetLimit() {
+float Team::getBudgetLimit() const {
     return budgetlimit;
 }
 
-Constructors Team::getConstructor() {
+const Constructors& Team::getConstructor() const {
     return constructor;
 }
 
 
-vector<Driver> Team::getDrivers() {
+const vector<Driver>& Team::getDrivers() const {
     return Drivers;
 }
 
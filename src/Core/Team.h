@@ -27,9 +27,9 @@ class Team {
     void removeDriver(Driver driver);
     void setConstructor(Constructors constructor);
 
-    float getBudgetLimit();
-    vector<Driver> getDrivers();
-    Constructors getConstructor();
+    float getBudgetLimit() const;
+    const vector<Driver>& getDrivers() const;
+    const Constructors& getConstructor() const;
 };
 
 
@@ -4,11 +4,12 @@
 
 #include "User.h"
 #include "Team.h"
+#include <utility>
 
 User::User(string username, float Budget, Team team) {
     this->username = username;
     this->budget = Budget;
-    this->team = team;
+    this->team = move(team);
 }
 
 void User::addPoints(int p) {
@@ -27,7 +28,7 @@ float User::getBudget() const {
     return budget;
 }
 
-Team User::getTeam() const {
+const Team& User::getTeam() const {
     return team;
 }
 
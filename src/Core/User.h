@@ -23,7 +23,7 @@ private:
     string getUsername() const;
     int getPoints() const;
     float getBudget() const;
-    Team getTeam() const;
+    const Team& getTeam() const;
 
     void addPoints(int p);
     void setPoints(int p);
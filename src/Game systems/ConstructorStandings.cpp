@@ -0,0 +1,76 @@
+//
+// Constructor Standings Implementation
+//
+
+#include "ConstructorStandings.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+// ============ CONSTRUCTOR ============
+
+ConstructorStandings::ConstructorStandings(vector<Constructors>& constructors)
+    : constructors(constructors), positionOf(constructors.size()) {
+    // The only full sort; races after this move single entries
+    order.reserve(constructors.size());
+    for (size_t i = 0; i < constructors.size(); i++) {
+        order.push_back((uint32_t)i);
+    }
+    sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return ranksAhead(a, b); });
+
+    for (size_t i = 0; i < order.size(); i++) {
+        positionOf[order[i]] = (uint32_t)i;
+    }
+}
+
+// ============ UPDATES ============
+
+bool ConstructorStandings::ranksAhead(uint32_t a, uint32_t b) const {
+    if (constructors[a].getPoints() != constructors[b].getPoints()) {
+        return constructors[a].getPoints() > constructors[b].getPoints();
+    }
+    return constructors[a].getTeamName() < constructors[b].getTeamName();
+}
+
+void ConstructorStandings::swapPositions(size_t i, size_t j) {
+    swap(order[i], order[j]);
+    positionOf[order[i]] = (uint32_t)i;
+    positionOf[order[j]] = (uint32_t)j;
+}
+
+void ConstructorStandings::applyRace(const vector<int>& points) {
+    for (size_t c = 0; c < points.size() && c < constructors.size(); c++) {
+        if (points[c] == 0) continue;
+
+        constructors[c].addpoints(points[c]);
+
+        // Everyone else is still in order, so one insertion step suffices
+        size_t pos = positionOf[c];
+        while (pos > 0 && ranksAhead((uint32_t)c, order[pos - 1])) {
+            swapPositions(pos, pos - 1);
+            pos--;
+        }
+        while (pos + 1 < order.size() && ranksAhead(order[pos + 1], (uint32_t)c)) {
+            swapPositions(pos, pos + 1);
+            pos++;
+        }
+    }
+}
+
+// ============ DISPLAY ============
+
+const vector<uint32_t>& ConstructorStandings::getOrder() const {
+    return order;
+}
+
+void ConstructorStandings::display() const {
+    cout << "Pos | Constructor          | Points" << endl;
+    cout << "--------------------------------------" << endl;
+
+    for (size_t i = 0; i < order.size(); i++) {
+        const Constructors& c = constructors[order[i]];
+        cout << setw(3) << (i + 1) << " | "
+             << setw(20) << left << c.getTeamName() << " | "
+             << setw(6) << right << c.getPoints() << endl;
+    }
+}
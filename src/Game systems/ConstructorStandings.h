@@ -0,0 +1,37 @@
+//
+// Constructor Standings
+// Keeps constructors ranked by points and repositions only the ones a race
+// changed, instead of re-sorting the whole table
+//
+
+#ifndef F1_FANTASY_DSA_CONSTRUCTORSTANDINGS_H
+#define F1_FANTASY_DSA_CONSTRUCTORSTANDINGS_H
+
+#include "../Core/Constructors.h"
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class ConstructorStandings {
+private:
+    vector<Constructors>& constructors;
+    vector<uint32_t> order;       // Constructor ids, leader first
+    vector<uint32_t> positionOf;  // Constructor id -> index in order
+
+    // Points descending, then team name ascending
+    bool ranksAhead(uint32_t a, uint32_t b) const;
+    void swapPositions(size_t i, size_t j);
+
+public:
+    // constructors must outlive the standings and never be resized
+    explicit ConstructorStandings(vector<Constructors>& constructors);
+
+    // Adds points[c] to constructor c and moves each changed constructor
+    // to its new place; O(changed x places moved)
+    void applyRace(const vector<int>& points);
+
+    const vector<uint32_t>& getOrder() const;
+    void display() const;
+};
+
+#endif //F1_FANTASY_DSA_CONSTRUCTORSTANDINGS_H
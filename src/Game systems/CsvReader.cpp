@@ -0,0 +1,223 @@
+//
+// Zero-copy CSV Reader Implementation
+//
+
+#include "CsvReader.h"
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSV_USE_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// ============ HELPER FUNCTIONS ============
+
+#ifdef CSV_USE_SSE2
+static inline int countTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+static inline string_view trimSpaces(string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t')) field.remove_suffix(1);
+    return field;
+}
+
+static inline void closeField(CsvRow& row, const char* start, const char* stop) {
+    // Tolerate CRLF files written on Windows
+    if (stop > start && stop[-1] == '\r') stop--;
+
+    if (row.fieldCount < CSV_MAX_FIELDS) {
+        row.fields[row.fieldCount] = string_view(start, stop - start);
+    }
+    row.fieldCount++;
+}
+
+// ============ CONSTRUCTOR ============
+
+CsvReader::CsvReader(const char* begin, const char* end, size_t firstLine)
+    : cursor(begin), end(end), lineNumber(firstLine) {}
+
+// ============ ROW SCANNING ============
+
+// Scans 16 bytes at a time for ',' and '\n', then walks the set bits of the
+// match mask so every delimiter in a block costs one bit-clear instead of a
+// byte compare. The scalar loop handles the tail and non-SSE2 builds.
+bool CsvReader::nextRow(CsvRow& row) {
+    if (cursor == nullptr || cursor >= end) return false;
+
+    row.fieldCount = 0;
+    row.line = lineNumber++;
+
+    const char* fieldStart = cursor;
+    const char* p = cursor;
+
+#ifdef CSV_USE_SSE2
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, newline)));
+
+        while (mask != 0) {
+            const char* hit = p + countTrailingZeros(mask);
+            mask &= mask - 1;
+
+            closeField(row, fieldStart, hit);
+            fieldStart = hit + 1;
+
+            if (*hit == '\n') {
+                cursor = hit + 1;
+                return true;
+            }
+        }
+        p += 16;
+    }
+#endif
+
+    for (; p < end; p++) {
+        if (*p == ',' || *p == '\n') {
+            closeField(row, fieldStart, p);
+            fieldStart = p + 1;
+
+            if (*p == '\n') {
+                cursor = p + 1;
+                return true;
+            }
+        }
+    }
+
+    // Last line without a trailing newline
+    closeField(row, fieldStart, end);
+    cursor = end;
+    return true;
+}
+
+const char* CsvReader::getPosition() const {
+    return cursor;
+}
+
+size_t CsvReader::getLineNumber() const {
+    return lineNumber;
+}
+
+vector<const char*> CsvReader::splitAtLines(const char* begin, const char* end, size_t count) {
+    vector<const char*> bounds;
+    bounds.push_back(begin);
+
+    size_t total = end - begin;
+    for (size_t i = 1; i < count; i++) {
+        const char* target = begin + total / count * i;
+        if (target <= bounds.back()) continue;
+
+        // Move forward to the start of the next line
+        const char* newline = (const char*)memchr(target, '\n', end - target);
+        if (newline == nullptr) break;
+        if (newline + 1 > bounds.back() && newline + 1 < end) {
+            bounds.push_back(newline + 1);
+        }
+    }
+
+    bounds.push_back(end);
+    return bounds;
+}
+
+// ============ ERROR REPORTING ============
+
+void CsvReader::addError(size_t line, const string& message) {
+    errors.push_back(CsvError(line, message));
+}
+
+const vector<CsvError>& CsvReader::getErrors() const {
+    return errors;
+}
+
+void CsvReader::reportErrors(const string& filename, const vector<CsvError>& errors) {
+    if (errors.empty()) return;
+
+    cout << "Warning: skipped " << errors.size() << " malformed row(s) in " << filename << endl;
+
+    // Don't flood the console when a whole file is bad
+    const size_t MAX_REPORTED = 10;
+    for (size_t i = 0; i < errors.size() && i < MAX_REPORTED; i++) {
+        cout << "  line " << errors[i].line << ": " << errors[i].message << endl;
+    }
+    if (errors.size() > MAX_REPORTED) {
+        cout << "  ... and " << (errors.size() - MAX_REPORTED) << " more" << endl;
+    }
+}
+
+// ============ FIELD PARSING ============
+
+bool CsvReader::parseInt(string_view field, int& value) {
+    field = trimSpaces(field);
+    if (field.empty()) return false;
+
+    size_t i = 0;
+    bool negative = false;
+    if (field[0] == '-' || field[0] == '+') {
+        negative = field[0] == '-';
+        i++;
+    }
+    if (i == field.size()) return false;
+
+    // A negative int reaches one further than a positive one
+    long long limit = negative ? 2147483648LL : 2147483647LL;
+    long long result = 0;
+    for (; i < field.size(); i++) {
+        char c = field[i];
+        if (c < '0' || c > '9') return false;
+        result = result * 10 + (c - '0');
+        if (result > limit) return false;
+    }
+
+    value = (int)(negative ? -result : result);
+    return true;
+}
+
+bool CsvReader::parseFloat(string_view field, float& value) {
+    field = trimSpaces(field);
+    if (field.empty()) return false;
+
+    size_t i = 0;
+    bool negative = false;
+    if (field[0] == '-' || field[0] == '+') {
+        negative = field[0] == '-';
+        i++;
+    }
+
+    double result = 0.0;
+    bool sawDigit = false;
+    for (; i < field.size() && field[i] >= '0' && field[i] <= '9'; i++) {
+        result = result * 10.0 + (field[i] - '0');
+        sawDigit = true;
+    }
+
+    if (i < field.size() && field[i] == '.') {
+        i++;
+        double scale = 0.1;
+        for (; i < field.size() && field[i] >= '0' && field[i] <= '9'; i++) {
+            result += (field[i] - '0') * scale;
+            scale *= 0.1;
+            sawDigit = true;
+        }
+    }
+
+    if (!sawDigit || i != field.size()) return false;
+
+    value = (float)(negative ? -result : result);
+    return true;
+}
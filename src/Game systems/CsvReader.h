@@ -0,0 +1,66 @@
+//
+// Zero-copy CSV Reader
+// Splits rows of a mapped file into string_view fields using a vectorized scan
+//
+
+#ifndef F1_FANTASY_DSA_CSVREADER_H
+#define F1_FANTASY_DSA_CSVREADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+const int CSV_MAX_FIELDS = 16;
+
+// One parsed row; fields point straight into the mapped file
+struct CsvRow {
+    string_view fields[CSV_MAX_FIELDS];
+    int fieldCount;
+    size_t line;  // 1-based line number in the file
+
+    CsvRow() : fieldCount(0), line(0) {}
+
+    bool isEmpty() const { return fieldCount == 1 && fields[0].empty(); }
+};
+
+// A malformed row, reported after loading
+struct CsvError {
+    size_t line;
+    string message;
+
+    CsvError(size_t l, string msg) : line(l), message(msg) {}
+};
+
+class CsvReader {
+private:
+    const char* cursor;
+    const char* end;
+    size_t lineNumber;
+    vector<CsvError> errors;
+
+public:
+    CsvReader(const char* begin, const char* end, size_t firstLine = 1);
+
+    // Reads the next row; returns false at end of input
+    bool nextRow(CsvRow& row);
+
+    // Where the next row starts, and its line number
+    const char* getPosition() const;
+    size_t getLineNumber() const;
+
+    // Splits [begin, end) into about `count` ranges that each end on a line
+    // boundary; returns count + 1 boundaries (fewer for small inputs)
+    static vector<const char*> splitAtLines(const char* begin, const char* end, size_t count);
+
+    // Error reporting
+    void addError(size_t line, const string& message);
+    const vector<CsvError>& getErrors() const;
+    static void reportErrors(const string& filename, const vector<CsvError>& errors);
+
+    // Field parsing (no allocation, rejects trailing garbage)
+    static bool parseInt(string_view field, int& value);
+    static bool parseFloat(string_view field, float& value);
+};
+
+#endif //F1_FANTASY_DSA_CSVREADER_H
@@ -11,9 +11,11 @@
 
 #include "../Core/Team.h"
 #include "../Core/Driver.h"
+#include "MappedFile.h"
+#include "CsvReader.h"
 // ============ CONSTRUCTOR ============
 
-Leaderboard::Leaderboard() {}
+Leaderboard::Leaderboard() : rankingsDirty(false) {}
 
 // ============ USER MANAGEMENT ============
 
@@ -28,14 +30,14 @@ void Leaderboard::addUser(User* user) {
     }
 
     users[username] = user;
-    rebuildRankings();
+    rankingsDirty = true;
 }
 
 void Leaderboard::removeUser(const string& username) {
     auto it = users.find(username);
     if (it != users.end()) {
         users.erase(it);
-        rebuildRankings();
+        rankingsDirty = true;
     }
 }
 
@@ -57,7 +59,7 @@ void Leaderboard::updateUserPoints(const string& username, int points) {
     User* user = getUser(username);
     if (user != nullptr) {
         // rebuild rankings
-        rebuildRankings();
+        rankingsDirty = true;
     }
 }
 
@@ -65,14 +67,25 @@ void Leaderboard::addPointsToUser(const string& username, int points) {
     User* user = getUser(username);
     if (user != nullptr) {
         user->addPoints(points);
-        rebuildRankings();
+        rankingsDirty = true;
     }
 }
 
+void Leaderboard::invalidateRankings() {
+    rankingsDirty = true;
+}
+
 // ============ RANKINGS ============
 
-void Leaderboard::rebuildRankings() {
+void Leaderboard::refreshRankings() const {
+    if (rankingsDirty) {
+        rebuildRankings();
+    }
+}
+
+void Leaderboard::rebuildRankings() const {
     sortedRankings.clear();
+    sortedRankings.reserve(users.size());
 
     // Build entries from users map
     for (auto& pair : users) {
@@ -83,9 +96,10 @@ void Leaderboard::rebuildRankings() {
     }
 
     sortRankings();
+    rankingsDirty = false;
 }
 
-void Leaderboard::sortRankings() {
+void Leaderboard::sortRankings() const {
     // Sort by points (descending), then by username (ascending)
     sort(sortedRankings.begin(), sortedRankings.end(),
          [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
@@ -102,7 +116,7 @@ void Leaderboard::sortRankings() {
 }
 
 vector<LeaderboardEntry> Leaderboard::getTopN(int n) {
-    rebuildRankings();  // Ensure up-to-date
+    refreshRankings();  // Ensure up-to-date
 
     vector<LeaderboardEntry> topN;
     int limit = min(n, (int)sortedRankings.size());
@@ -115,12 +129,12 @@ vector<LeaderboardEntry> Leaderboard::getTopN(int n) {
 }
 
 vector<LeaderboardEntry> Leaderboard::getAllRankings() {
-    rebuildRankings();
+    refreshRankings();
     return sortedRankings;
 }
 
 int Leaderboard::getUserRank(const string& username) {
-    rebuildRankings();
+    refreshRankings();
 
     for (const LeaderboardEntry& entry : sortedRankings) {
         if (entry.username == username) {
@@ -149,6 +163,7 @@ int Leaderboard::getAveragePoints() const {
 }
 
 LeaderboardEntry Leaderboard::getLeader() const {
+    refreshRankings();
     if (sortedRankings.empty()) {
         return LeaderboardEntry("", 0, 0);
     }
@@ -237,7 +252,7 @@ void Leaderboard::displayUserStats(const string& username) {
 bool Leaderboard::exportToFile(const string& filename) {
     ofstream file(filename);
 
-    rebuildRankings();
+    refreshRankings();
 
     // Header
     file << "=== F1 FANTASY LEAGUE LEADERBOARD ===" << endl;
@@ -258,10 +273,97 @@ bool Leaderboard::exportToFile(const string& filename) {
     return true;
 }
 
+// Reads the exportToFile layout in one pass over the mapped file. Each row must
+// name a known user with their current points, in rank order, so a file left
+// behind by an older session is rejected instead of trusted.
+bool Leaderboard::loadFromFile(const string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    CsvReader reader(file.begin(), file.end());
+    CsvRow row;
+
+    // Header
+    const string_view TITLE = "=== F1 FANTASY LEAGUE LEADERBOARD ===";
+    const string_view PLAYERS = "Total Players: ";
+    const string_view AVERAGE = "Average Points: ";
+    int totalPlayers, averagePoints;
+
+    if (!reader.nextRow(row) || row.fieldCount != 1 || row.fields[0] != TITLE) {
+        return false;
+    }
+    if (!reader.nextRow(row) || row.fieldCount != 1 ||
+        row.fields[0].substr(0, PLAYERS.size()) != PLAYERS ||
+        !CsvReader::parseInt(row.fields[0].substr(PLAYERS.size()), totalPlayers)) {
+        return false;
+    }
+    if (!reader.nextRow(row) || row.fieldCount != 1 ||
+        row.fields[0].substr(0, AVERAGE.size()) != AVERAGE ||
+        !CsvReader::parseInt(row.fields[0].substr(AVERAGE.size()), averagePoints)) {
+        return false;
+    }
+    if (!reader.nextRow(row) || !row.isEmpty()) {
+        return false;
+    }
+    if (!reader.nextRow(row) || row.fieldCount != 4 || row.fields[0] != "Rank") {
+        return false;
+    }
+
+    // Cheap checks first: a count mismatch means users were added since
+    if (totalPlayers != getTotalUsers() || averagePoints != getAveragePoints()) {
+        return false;
+    }
+
+    vector<LeaderboardEntry> loaded;
+    loaded.reserve(totalPlayers);
+
+    while (reader.nextRow(row)) {
+        if (row.isEmpty()) continue;
+
+        int rank, points;
+        if (row.fieldCount != 4 ||
+            !CsvReader::parseInt(row.fields[0], rank) ||
+            !CsvReader::parseInt(row.fields[2], points)) {
+            return false;
+        }
+
+        if (rank != (int)loaded.size() + 1 || rank > totalPlayers) {
+            return false;
+        }
+
+        auto it = users.find(string(row.fields[1]));
+        if (it == users.end() || it->second->getPoints() != points) {
+            return false;
+        }
+
+        // Strictly in sortRankings order, which also rules out duplicates
+        if (!loaded.empty()) {
+            const LeaderboardEntry& previous = loaded.back();
+            if (previous.points < points ||
+                (previous.points == points && previous.username >= it->first)) {
+                return false;
+            }
+        }
+
+        // Budget comes from the user; the file only keeps 6 digits of it
+        loaded.push_back(LeaderboardEntry(it->first, points, it->second->getBudget(), rank));
+    }
+
+    if ((int)loaded.size() != totalPlayers) {
+        return false;
+    }
+
+    sortedRankings = move(loaded);
+    rankingsDirty = false;
+    return true;
+}
 
 // ============ UTILITY ============
 
 void Leaderboard::clear() {
     users.clear();
     sortedRankings.clear();
+    rankingsDirty = false;
 }
\ No newline at end of file
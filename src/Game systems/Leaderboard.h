@@ -36,11 +36,13 @@ struct ComparePoints {
 class Leaderboard {
 private:
     unordered_map<string, User*> users;  // Fast O(1) lookup by username
-    vector<LeaderboardEntry> sortedRankings;  // Stable sorted list
+    mutable vector<LeaderboardEntry> sortedRankings;  // Stable sorted list
+    mutable bool rankingsDirty;  // Rebuilt on the next read, not on every change
 
     // Helper functions
-    void rebuildRankings();
-    void sortRankings();
+    void refreshRankings() const;
+    void rebuildRankings() const;
+    void sortRankings() const;
 
 public:
     Leaderboard();
@@ -54,6 +56,7 @@ public:
     // Points updates
     void updateUserPoints(const string& username, int points);
     void addPointsToUser(const string& username, int points);
+    void invalidateRankings();  // Call after changing user points directly
 
     // Rankings
     vector<LeaderboardEntry> getTopN(int n);
@@ -72,6 +75,9 @@ public:
 
     // File operations
     bool exportToFile(const string& filename);
+
+    // Adopts the rankings of an exported file without sorting, if they
+    // still match the users added so far; otherwise rankings are rebuilt
     bool loadFromFile(const string& filename);
 
     // Utility
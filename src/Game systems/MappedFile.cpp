@@ -0,0 +1,143 @@
+//
+// Memory-mapped File Implementation
+//
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+#ifdef _WIN32
+MappedFile::MappedFile()
+    : mappedData(nullptr), mappedSize(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : mappedData(nullptr), mappedSize(0), fileDescriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// ============ OPEN & CLOSE ============
+
+#ifdef _WIN32
+
+bool MappedFile::open(const string& filename) {
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappedSize = (size_t)fileSize.QuadPart;
+
+    // Empty files can't be mapped, but they are still valid (no rows)
+    if (mappedSize == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+
+    mappedData = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (mappedData == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (mappedData != nullptr) UnmapViewOfFile(mappedData);
+    if (mappingHandle != nullptr) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle != nullptr) CloseHandle((HANDLE)fileHandle);
+
+    mappedData = nullptr;
+    mappedSize = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+bool MappedFile::isOpen() const {
+    return fileHandle != nullptr;
+}
+
+#else
+
+bool MappedFile::open(const string& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    fileDescriptor = fd;
+    mappedSize = (size_t)info.st_size;
+
+    // Empty files can't be mapped, but they are still valid (no rows)
+    if (mappedSize == 0) return true;
+
+    void* addr = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    // We only ever scan front to back
+    madvise(addr, mappedSize, MADV_SEQUENTIAL);
+    mappedData = (const char*)addr;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mappedData != nullptr) munmap((void*)mappedData, mappedSize);
+    if (fileDescriptor >= 0) ::close(fileDescriptor);
+
+    mappedData = nullptr;
+    mappedSize = 0;
+    fileDescriptor = -1;
+}
+
+bool MappedFile::isOpen() const {
+    return fileDescriptor >= 0;
+}
+
+#endif
+
+// ============ ACCESSORS ============
+
+const char* MappedFile::begin() const {
+    return mappedData;
+}
+
+const char* MappedFile::end() const {
+    return mappedData == nullptr ? nullptr : mappedData + mappedSize;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
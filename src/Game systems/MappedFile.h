@@ -0,0 +1,42 @@
+//
+// Memory-mapped read-only file
+// Maps a whole file into memory so loaders can parse it without copying
+//
+
+#ifndef F1_FANTASY_DSA_MAPPEDFILE_H
+#define F1_FANTASY_DSA_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+using namespace std;
+
+class MappedFile {
+private:
+    const char* mappedData;
+    size_t mappedSize;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Mapping owns OS handles, so it can't be copied
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& filename);
+    void close();
+
+    bool isOpen() const;
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+};
+
+#endif //F1_FANTASY_DSA_MAPPEDFILE_H
@@ -0,0 +1,247 @@
+//
+// Monte Carlo Season Engine Implementation
+//
+
+#include "MonteCarloSeason.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+// ============ HELPER FUNCTIONS ============
+
+// Sorts ids by final points, best first; equal points keep id order
+static void rankByPoints(const vector<int>& finals, size_t count, vector<uint32_t>& order) {
+    order.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = (uint32_t)i;
+    }
+    sort(order.begin(), order.end(), [&finals](uint32_t a, uint32_t b) {
+        if (finals[a] != finals[b]) return finals[a] > finals[b];
+        return a < b;
+    });
+}
+
+// Smallest rank whose cumulative share reaches p
+static int rankPercentile(const uint64_t* histogram, size_t ranks, size_t seasons, double p) {
+    uint64_t needed = (uint64_t)(p * seasons + 0.5);
+    if (needed == 0) needed = 1;
+
+    uint64_t seen = 0;
+    for (size_t r = 0; r < ranks; r++) {
+        seen += histogram[r];
+        if (seen >= needed) return (int)(r + 1);
+    }
+    return (int)ranks;
+}
+
+// ============ CONSTRUCTOR ============
+
+MonteCarloSeason::MonteCarloSeason(const vector<Driver>& drivers, const vector<User*>& users,
+                                   const ScoringIndex& scoring)
+    : drivers(drivers), users(users), scoring(scoring), seasonsRun(0), lapsPerRace(0) {}
+
+bool MonteCarloSeason::tracksUserRanks() const {
+    return users.size() <= MAX_RANKED_USERS;
+}
+
+// ============ SIMULATION ============
+
+void MonteCarloSeason::prepareScratch(Scratch& scratch, int races) const {
+    // The copy is only ever assigned over from now on, so the simulator's
+    // driver pointers stay valid
+    scratch.drivers = drivers;
+    scratch.simulator.setEventSink(RaceEventSink::none());
+    scratch.simulator.setLapCount(lapsPerRace);
+    for (Driver& d : scratch.drivers) {
+        scratch.simulator.addDriver(&d);
+    }
+    scratch.races.reserve(races, drivers.size());
+}
+
+void MonteCarloSeason::simulateSeason(size_t season, int races, uint64_t seed,
+                                      Tally& tally, Scratch& scratch) const {
+    size_t driverCount = drivers.size();
+    size_t userCount = users.size();
+
+    // Points feed back into each race's form, so every season starts from
+    // its own copy of today's standings
+    scratch.drivers = drivers;
+
+    // The worker's simulator restarts on this season's stream, so results
+    // match a fresh simulator per season
+    scratch.simulator.reseed(seed, season);
+    scratch.simulator.runRaces(races, scratch.races);
+
+    // Drivers: slots are indices into the drivers list
+    scratch.driverGains.assign(driverCount, 0);
+    for (size_t r = 0; r < scratch.races.raceCount; r++) {
+        const int* slots = scratch.races.slotsOf(r);
+        const int* points = scratch.races.pointsOf(r);
+        for (size_t p = 0; p < driverCount; p++) {
+            scratch.driverGains[slots[p]] += points[p];
+        }
+    }
+
+    scratch.finals.resize(driverCount);
+    for (size_t d = 0; d < driverCount; d++) {
+        scratch.finals[d] = drivers[d].getPoints() + scratch.driverGains[d];
+        tally.driverPoints[d] += scratch.finals[d];
+    }
+
+    rankByPoints(scratch.finals, driverCount, scratch.order);
+    tally.driverWins[scratch.order[0]]++;
+    for (size_t rank = 0; rank < driverCount; rank++) {
+        tally.driverRanks[scratch.order[rank] * driverCount + rank]++;
+    }
+
+    // Users: each unique team is scored once, then members add their own
+    // starting points
+    if (userCount == 0) return;
+
+    scoring.projectGroupPoints(scratch.driverGains, scratch.groupPoints, scratch.projection);
+    const vector<uint32_t>& groupOfUser = scoring.getGroupOfUser();
+
+    scratch.finals.resize(userCount);
+    size_t leader = 0;
+    for (size_t u = 0; u < userCount; u++) {
+        int gain = u < groupOfUser.size() ? scratch.groupPoints[groupOfUser[u]] : 0;
+        scratch.finals[u] = users[u]->getPoints() + gain;
+        tally.userPoints[u] += scratch.finals[u];
+
+        if (scratch.finals[u] > scratch.finals[leader]) {
+            leader = u;
+        }
+    }
+    tally.userWins[leader]++;
+
+    if (tracksUserRanks()) {
+        rankByPoints(scratch.finals, userCount, scratch.order);
+        for (size_t rank = 0; rank < userCount; rank++) {
+            tally.userRanks[scratch.order[rank] * userCount + rank]++;
+        }
+    }
+}
+
+void MonteCarloSeason::run(size_t seasons, int racesPerSeason, uint64_t seed, int lapsPerRace) {
+    size_t driverCount = drivers.size();
+    size_t userCount = users.size();
+    driverStats.clear();
+    userStats.clear();
+    seasonsRun = seasons;
+    this->lapsPerRace = lapsPerRace;
+
+    if (seasons == 0 || driverCount == 0) return;
+
+    // One contiguous block of seasons per thread, each with private tallies
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workers = min(pool.concurrency(), seasons);
+    vector<Tally> tallies(workers);
+
+    pool.parallelFor(workers, [&](size_t w) {
+        Tally& tally = tallies[w];
+        tally.driverWins.assign(driverCount, 0);
+        tally.driverPoints.assign(driverCount, 0);
+        tally.driverRanks.assign(driverCount * driverCount, 0);
+        tally.userWins.assign(userCount, 0);
+        tally.userPoints.assign(userCount, 0);
+        tally.userRanks.assign(tracksUserRanks() ? userCount * userCount : 0, 0);
+
+        Scratch scratch;
+        prepareScratch(scratch, racesPerSeason);
+        size_t begin = seasons * w / workers;
+        size_t end = seasons * (w + 1) / workers;
+        for (size_t s = begin; s < end; s++) {
+            simulateSeason(s, racesPerSeason, seed, tally, scratch);
+        }
+    });
+
+    // Merge
+    Tally& total = tallies[0];
+    for (size_t w = 1; w < workers; w++) {
+        for (size_t i = 0; i < total.driverWins.size(); i++) total.driverWins[i] += tallies[w].driverWins[i];
+        for (size_t i = 0; i < total.driverPoints.size(); i++) total.driverPoints[i] += tallies[w].driverPoints[i];
+        for (size_t i = 0; i < total.driverRanks.size(); i++) total.driverRanks[i] += tallies[w].driverRanks[i];
+        for (size_t i = 0; i < total.userWins.size(); i++) total.userWins[i] += tallies[w].userWins[i];
+        for (size_t i = 0; i < total.userPoints.size(); i++) total.userPoints[i] += tallies[w].userPoints[i];
+        for (size_t i = 0; i < total.userRanks.size(); i++) total.userRanks[i] += tallies[w].userRanks[i];
+    }
+
+    driverStats.resize(driverCount);
+    for (size_t d = 0; d < driverCount; d++) {
+        ProjectionStats& stats = driverStats[d];
+        stats.name = drivers[d].getName();
+        stats.winProbability = (double)total.driverWins[d] / seasons;
+        stats.expectedPoints = (double)total.driverPoints[d] / seasons;
+
+        const uint64_t* histogram = &total.driverRanks[d * driverCount];
+        stats.rankP10 = rankPercentile(histogram, driverCount, seasons, 0.1);
+        stats.rankP50 = rankPercentile(histogram, driverCount, seasons, 0.5);
+        stats.rankP90 = rankPercentile(histogram, driverCount, seasons, 0.9);
+    }
+
+    userStats.resize(userCount);
+    for (size_t u = 0; u < userCount; u++) {
+        ProjectionStats& stats = userStats[u];
+        stats.name = users[u]->getUsername();
+        stats.winProbability = (double)total.userWins[u] / seasons;
+        stats.expectedPoints = (double)total.userPoints[u] / seasons;
+
+        if (tracksUserRanks()) {
+            const uint64_t* histogram = &total.userRanks[u * userCount];
+            stats.rankP10 = rankPercentile(histogram, userCount, seasons, 0.1);
+            stats.rankP50 = rankPercentile(histogram, userCount, seasons, 0.5);
+            stats.rankP90 = rankPercentile(histogram, userCount, seasons, 0.9);
+        }
+    }
+}
+
+// ============ GETTERS ============
+
+const vector<ProjectionStats>& MonteCarloSeason::getDriverStats() const {
+    return driverStats;
+}
+
+const vector<ProjectionStats>& MonteCarloSeason::getUserStats() const {
+    return userStats;
+}
+
+// ============ DISPLAY ============
+
+static void displayTable(const vector<ProjectionStats>& rows, size_t limit, bool showRanks) {
+    cout << "Name                  |  Win % | Exp. Pts";
+    if (showRanks) cout << " | Rank P10/P50/P90";
+    cout << endl;
+    cout << "-------------------------------------------------------------" << endl;
+
+    for (size_t i = 0; i < rows.size() && i < limit; i++) {
+        const ProjectionStats& stats = rows[i];
+        cout << setw(21) << left << stats.name << " | "
+             << setw(6) << right << fixed << setprecision(2) << stats.winProbability * 100 << " | "
+             << setw(8) << setprecision(1) << stats.expectedPoints;
+        if (showRanks) {
+            cout << " | " << stats.rankP10 << "/" << stats.rankP50 << "/" << stats.rankP90;
+        }
+        cout << endl;
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void MonteCarloSeason::display(size_t topUsers) const {
+    // Most likely champions first
+    auto byOdds = [](const ProjectionStats& a, const ProjectionStats& b) {
+        if (a.winProbability != b.winProbability) return a.winProbability > b.winProbability;
+        return a.expectedPoints > b.expectedPoints;
+    };
+
+    vector<ProjectionStats> rows = driverStats;
+    stable_sort(rows.begin(), rows.end(), byOdds);
+    cout << "\n=== DRIVER CHAMPIONSHIP PROJECTION (" << seasonsRun << " seasons) ===" << endl;
+    displayTable(rows, rows.size(), true);
+
+    rows = userStats;
+    stable_sort(rows.begin(), rows.end(), byOdds);
+    cout << "\n=== LEAGUE PROJECTION: TOP " << min(topUsers, rows.size()) << " USERS ===" << endl;
+    displayTable(rows, topUsers, tracksUserRanks());
+}
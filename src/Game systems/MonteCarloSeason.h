@@ -0,0 +1,91 @@
+//
+// Monte Carlo Season Engine
+// Simulates many independent seasons across the thread pool and reports
+// championship odds for every driver and user
+//
+
+#ifndef F1_FANTASY_DSA_MONTECARLOSEASON_H
+#define F1_FANTASY_DSA_MONTECARLOSEASON_H
+
+#include "../Core/Driver.h"
+#include "../Core/User.h"
+#include "ScoringIndex.h"
+#include "RaceSimulator.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Outcome distribution for one driver or user over all simulated seasons
+struct ProjectionStats {
+    string name;
+    double winProbability;
+    double expectedPoints;  // Final total, current points included
+    int rankP10;            // Rank percentiles; 0 when ranks weren't tracked
+    int rankP50;
+    int rankP90;
+
+    ProjectionStats() : winProbability(0), expectedPoints(0), rankP10(0), rankP50(0), rankP90(0) {}
+};
+
+class MonteCarloSeason {
+private:
+    const vector<Driver>& drivers;
+    const vector<User*>& users;
+    const ScoringIndex& scoring;
+
+    vector<ProjectionStats> driverStats;
+    vector<ProjectionStats> userStats;
+    size_t seasonsRun;
+    int lapsPerRace;
+
+    // Per-worker counters. Everything is an integer sum, so merging workers
+    // in any order gives the same totals whatever the thread count.
+    struct Tally {
+        vector<uint64_t> driverWins;
+        vector<int64_t> driverPoints;
+        vector<uint64_t> driverRanks;  // driver * driverCount + rank
+        vector<uint64_t> userWins;
+        vector<int64_t> userPoints;
+        vector<uint64_t> userRanks;    // user * userCount + rank, if tracked
+    };
+
+    // Reused across a worker's seasons, so the season loop doesn't
+    // allocate once the first season has sized everything
+    struct Scratch {
+        vector<Driver> drivers;
+        RaceSimulator simulator;  // Entrants point into drivers
+        RaceBatch races;
+        vector<int> driverGains;
+        vector<int> groupPoints;
+        GroupProjectionScratch projection;
+        vector<int> finals;
+        vector<uint32_t> order;
+
+        Scratch() : simulator("", 0) {}
+    };
+
+    bool tracksUserRanks() const;
+    void prepareScratch(Scratch& scratch, int races) const;
+    void simulateSeason(size_t season, int races, uint64_t seed, Tally& tally, Scratch& scratch) const;
+
+public:
+    // Rank histograms are users x users, so bigger leagues only get odds
+    // and expected points
+    static const size_t MAX_RANKED_USERS = 1024;
+
+    // Reads the current standings; never modifies them
+    MonteCarloSeason(const vector<Driver>& drivers, const vector<User*>& users, const ScoringIndex& scoring);
+
+    // Season s draws only from stream (seed, s), so results depend on
+    // the seed alone, not on how seasons are spread over threads.
+    // lapsPerRace > 0 uses the lap-by-lap race model.
+    void run(size_t seasons, int racesPerSeason, uint64_t seed, int lapsPerRace = 0);
+
+    const vector<ProjectionStats>& getDriverStats() const;
+    const vector<ProjectionStats>& getUserStats() const;
+
+    void display(size_t topUsers = 10) const;
+};
+
+#endif //F1_FANTASY_DSA_MONTECARLOSEASON_H
@@ -0,0 +1,331 @@
+//
+// Points Journal Implementation
+//
+
+#include "PointsJournal.h"
+#include "MappedFile.h"
+#include "CsvReader.h"
+#include "../Core/Team.h"
+#include <filesystem>
+#include <sstream>
+
+// Never compact more often than this, however small the base files are
+const size_t MIN_COMPACTION_ENTRIES = 4096;
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+PointsJournal::PointsJournal(const string& filename)
+    : filename(filename), entriesSinceCompaction(0),
+      stopping(false), writerBusy(false), writeFailed(false), compactionFailed(false),
+      compactionFailureUnreported(false) {
+    openForAppend();
+    writer = thread(&PointsJournal::writerLoop, this);
+}
+
+PointsJournal::~PointsJournal() {
+    commit();
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_one();
+    writer.join();
+    out.close();
+}
+
+string PointsJournal::compactingFilename() const {
+    return filename + ".compacting";
+}
+
+void PointsJournal::openForAppend() {
+    out.open(filename, ios::app);
+}
+
+// ============ REPLAY ============
+
+int PointsJournal::replay(vector<Driver>& drivers, vector<Constructors>& constructors, vector<User*>& users) {
+    // A journal left by an unfinished compaction is older than the active one
+    int applied = replayFile(compactingFilename(), drivers, constructors, users);
+    applied += replayFile(filename, drivers, constructors, users);
+
+    entriesSinceCompaction += applied;
+    return applied;
+}
+
+int PointsJournal::replayFile(const string& path, vector<Driver>& drivers,
+                              vector<Constructors>& constructors, vector<User*>& users) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+
+    CsvReader reader(file.begin(), file.end());
+    CsvRow row;
+    int applied = 0;
+
+    while (reader.nextRow(row)) {
+        if (row.isEmpty()) continue;
+
+        string_view type = row.fields[0];
+        int index, delta, total;
+
+        if (type == "R") {
+            continue;
+        }
+
+        if (row.fieldCount < 3 || !CsvReader::parseInt(row.fields[1], index) || index < 0) {
+            reader.addError(row.line, "missing record index");
+            continue;
+        }
+
+        if (type == "D") {
+            if (row.fieldCount != 5 ||
+                !CsvReader::parseInt(row.fields[3], delta) ||
+                !CsvReader::parseInt(row.fields[4], total)) {
+                reader.addError(row.line, "expected D,index,code,delta,total");
+                continue;
+            }
+            if (index >= (int)drivers.size() || drivers[index].getCode() != row.fields[2]) {
+                reader.addError(row.line, "driver '" + string(row.fields[2]) + "' does not match drivers file");
+                continue;
+            }
+            drivers[index].addpoints(total - drivers[index].getPoints());
+            applied++;
+        } else if (type == "C") {
+            if (row.fieldCount != 5 ||
+                !CsvReader::parseInt(row.fields[3], delta) ||
+                !CsvReader::parseInt(row.fields[4], total)) {
+                reader.addError(row.line, "expected C,index,code,delta,total");
+                continue;
+            }
+            if (index >= (int)constructors.size() || constructors[index].getCode() != row.fields[2]) {
+                reader.addError(row.line, "constructor '" + string(row.fields[2]) + "' does not match constructors file");
+                continue;
+            }
+            constructors[index].addpoints(total - constructors[index].getPoints());
+            applied++;
+        } else if (type == "U") {
+            if (row.fieldCount != 5 ||
+                !CsvReader::parseInt(row.fields[3], delta) ||
+                !CsvReader::parseInt(row.fields[4], total)) {
+                reader.addError(row.line, "expected U,index,username,delta,total");
+                continue;
+            }
+            if (index >= (int)users.size() || users[index]->getUsername() != row.fields[2]) {
+                reader.addError(row.line, "user '" + string(row.fields[2]) + "' does not match users file");
+                continue;
+            }
+            users[index]->setPoints(total);
+            applied++;
+        } else if (type == "T") {
+            float budget;
+            if (row.fieldCount < 6 || row.fieldCount > CSV_MAX_FIELDS ||
+                !CsvReader::parseFloat(row.fields[3], budget) ||
+                !CsvReader::parseInt(row.fields[row.fieldCount - 1], total)) {
+                reader.addError(row.line, "expected T,index,username,budget,constructor,drivers...,points");
+                continue;
+            }
+
+            // Already folded into the users file by an earlier compaction
+            if (index < (int)users.size()) {
+                continue;
+            }
+            if (index > (int)users.size()) {
+                reader.addError(row.line, "team for '" + string(row.fields[2]) + "' is out of order");
+                continue;
+            }
+
+            // New teams are rare, so plain scans are fine here
+            Constructors constructor("UNK", "Unknown", 10.0);
+            for (const Constructors& c : constructors) {
+                if (c.getTeamName() == row.fields[4]) {
+                    constructor = c;
+                    break;
+                }
+            }
+
+            Team team(budget, constructor);
+            for (int i = 5; i < row.fieldCount - 1; i++) {
+                for (const Driver& d : drivers) {
+                    if (d.getName() == row.fields[i]) {
+                        team.addDriver(d);
+                        break;
+                    }
+                }
+            }
+
+            User* user = new User(string(row.fields[2]), budget, move(team));
+            user->setPoints(total);
+            users.push_back(user);
+            applied++;
+        } else {
+            reader.addError(row.line, "unknown record type '" + string(type) + "'");
+        }
+    }
+
+    CsvReader::reportErrors(path, reader.getErrors());
+    return applied;
+}
+
+// ============ RECORDING ============
+
+void PointsJournal::beginRace(const string& raceName) {
+    staging += "R,";
+    staging += raceName;
+    staging += "\n";
+}
+
+void PointsJournal::recordDriver(size_t index, const Driver& driver, int delta) {
+    staging += "D," + to_string(index) + "," + driver.getCode() + "," +
+               to_string(delta) + "," + to_string(driver.getPoints()) + "\n";
+    entriesSinceCompaction++;
+}
+
+void PointsJournal::recordConstructor(size_t index, const Constructors& constructor, int delta) {
+    staging += "C," + to_string(index) + "," + constructor.getCode() + "," +
+               to_string(delta) + "," + to_string(constructor.getPoints()) + "\n";
+    entriesSinceCompaction++;
+}
+
+void PointsJournal::recordUser(size_t index, const User& user, int delta) {
+    staging += "U," + to_string(index) + "," + user.getUsername() + "," +
+               to_string(delta) + "," + to_string(user.getPoints()) + "\n";
+    entriesSinceCompaction++;
+}
+
+void PointsJournal::recordNewTeam(size_t index, const User& user) {
+    const Team& team = user.getTeam();
+
+    // Budget goes through a stream so it is formatted exactly like users.csv
+    ostringstream line;
+    line << "T," << index << "," << user.getUsername() << "," << user.getBudget() << ","
+         << team.getConstructor().getTeamName() << ",";
+    for (const Driver& d : team.getDrivers()) {
+        line << d.getName() << ",";
+    }
+    line << user.getPoints() << "\n";
+
+    staging += line.str();
+    entriesSinceCompaction++;
+}
+
+bool PointsJournal::commit() {
+    if (!staging.empty()) {
+        JournalJob job;
+        job.records.swap(staging);
+        enqueue(move(job));
+    }
+    return !writeFailed;
+}
+
+// ============ COMPACTION ============
+
+bool PointsJournal::needsCompaction(size_t baseRows) const {
+    size_t threshold = baseRows > MIN_COMPACTION_ENTRIES ? baseRows : MIN_COMPACTION_ENTRIES;
+    return entriesSinceCompaction >= threshold;
+}
+
+bool PointsJournal::takeCompactionFailure() {
+    return compactionFailureUnreported.exchange(false);
+}
+
+void PointsJournal::enqueueWrite(function<void()> write) {
+    JournalJob job;
+    job.write = move(write);
+    enqueue(move(job));
+}
+
+void PointsJournal::compact(function<bool()> writeBase) {
+    // Records committed before this point belong to the compacted state
+    commit();
+
+    JournalJob job;
+    job.writeBase = move(writeBase);
+    enqueue(move(job));
+    entriesSinceCompaction = 0;
+}
+
+void PointsJournal::rotateAndCompact(const function<bool()>& writeBase) {
+    out.close();
+
+    // Move the active journal aside so records committed during the rewrite
+    // land in a fresh file. If an earlier compaction failed, its records are
+    // still pending, so fold the active journal into them.
+    string compacting = compactingFilename();
+    error_code ec;
+    if (filesystem::exists(compacting, ec)) {
+        ifstream active(filename, ios::binary);
+        ofstream pending(compacting, ios::binary | ios::app);
+        pending << active.rdbuf();
+        active.close();
+        pending.close();
+        filesystem::remove(filename, ec);
+    } else {
+        filesystem::rename(filename, compacting, ec);
+    }
+
+    openForAppend();
+
+    // writeBase captures a copy of the state, so nothing here is shared.
+    // Appends still work after a failed compaction, so it is reported once
+    // rather than failing every later commit.
+    if (writeBase()) {
+        filesystem::remove(compacting, ec);
+        compactionFailed = false;
+    } else if (!compactionFailed) {
+        compactionFailed = true;
+        compactionFailureUnreported = true;
+    }
+}
+
+// ============ WRITER THREAD ============
+
+void PointsJournal::enqueue(JournalJob job) {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        queue.push_back(move(job));
+    }
+    queueChanged.notify_one();
+}
+
+void PointsJournal::writerLoop() {
+    deque<JournalJob> batch;
+
+    while (true) {
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) break;  // Stopping and fully drained
+
+            batch.swap(queue);
+            writerBusy = true;
+        }
+
+        // Group commit: consecutive record batches share one flush; a
+        // compaction only flushes what was queued ahead of it
+        for (JournalJob& job : batch) {
+            if (job.writeBase) {
+                out.flush();
+                rotateAndCompact(job.writeBase);
+            } else if (job.write) {
+                job.write();
+            } else {
+                out.write(job.records.data(), (streamsize)job.records.size());
+            }
+        }
+        out.flush();
+        if (!out.good()) writeFailed = true;
+        batch.clear();
+
+        {
+            lock_guard<mutex> lock(queueMutex);
+            writerBusy = false;
+        }
+        queueDrained.notify_all();
+    }
+}
+
+void PointsJournal::waitForWrites() {
+    commit();
+
+    unique_lock<mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this] { return queue.empty() && !writerBusy; });
+}
@@ -0,0 +1,107 @@
+//
+// Append-only Points Journal
+// Records per-race point changes instead of rewriting the CSVs every race
+//
+
+#ifndef F1_FANTASY_DSA_POINTSJOURNAL_H
+#define F1_FANTASY_DSA_POINTSJOURNAL_H
+
+#include "../Core/Driver.h"
+#include "../Core/Constructors.h"
+#include "../Core/User.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Work for the writer thread: a committed batch of journal lines, a
+// compaction that rewrites the base files, or a write to some other file
+struct JournalJob {
+    string records;
+    function<bool()> writeBase;
+    function<void()> write;
+};
+
+// Journal lines (CSV, one record per line):
+//   R,raceName
+//   D,driverIndex,code,delta,total
+//   C,constructorIndex,code,delta,total
+//   U,userIndex,username,delta,total
+//   T,userIndex,username,budget,constructor,driver_1,driver_2,points
+//
+// Entities are identified by their row in the matching CSV, with the
+// name stored alongside as a consistency check. Records carry the resulting
+// total as well as the delta, so replaying a record twice is harmless.
+//
+// All disk I/O happens on one writer thread. Callers stage records in
+// memory and commit() hands them over without waiting; the writer drains
+// everything queued since its last wake-up with a single write and flush.
+class PointsJournal {
+private:
+    string filename;
+    ofstream out;                    // writer thread only
+    string staging;                  // caller thread only
+    size_t entriesSinceCompaction;   // caller thread only
+
+    deque<JournalJob> queue;
+    mutex queueMutex;
+    condition_variable queueChanged;
+    condition_variable queueDrained;
+    bool stopping;
+    bool writerBusy;
+    atomic<bool> writeFailed;        // A journal append failed
+    bool compactionFailed;           // writer thread only
+    atomic<bool> compactionFailureUnreported;
+    thread writer;
+
+    string compactingFilename() const;
+    void openForAppend();
+    void enqueue(JournalJob job);
+    void writerLoop();
+    void rotateAndCompact(const function<bool()>& writeBase);
+    int replayFile(const string& path, vector<Driver>& drivers,
+                   vector<Constructors>& constructors, vector<User*>& users);
+
+public:
+    PointsJournal(const string& filename);
+    ~PointsJournal();
+
+    PointsJournal(const PointsJournal&) = delete;
+    PointsJournal& operator=(const PointsJournal&) = delete;
+
+    // Applies every record left since the last compaction to the loaded
+    // base state; returns the number of records applied
+    int replay(vector<Driver>& drivers, vector<Constructors>& constructors, vector<User*>& users);
+
+    // Recording
+    void beginRace(const string& raceName);
+    void recordDriver(size_t index, const Driver& driver, int delta);
+    void recordConstructor(size_t index, const Constructors& constructor, int delta);
+    void recordUser(size_t index, const User& user, int delta);
+    void recordNewTeam(size_t index, const User& user);
+    bool commit();
+
+    // Compaction: once the journal holds about as many records as the base
+    // files have rows, fold it into them on the writer thread
+    bool needsCompaction(size_t baseRows) const;
+    void compact(function<bool()> writeBase);
+
+    // Runs write on the writer thread, after everything committed before
+    // it, so other files can be saved without blocking the caller
+    void enqueueWrite(function<void()> write);
+
+    // True once per run of failed compactions. The writer thread never
+    // prints, so the caller reports this from its own thread.
+    bool takeCompactionFailure();
+
+    // Blocks until everything committed so far is on disk
+    void waitForWrites();
+};
+
+#endif //F1_FANTASY_DSA_POINTSJOURNAL_H
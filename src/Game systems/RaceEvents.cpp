@@ -0,0 +1,104 @@
+//
+// Race Event Sinks Implementation
+//
+
+#include "RaceEvents.h"
+#include <iostream>
+
+// ============ SHARED SINKS ============
+
+RaceEventSink& RaceEventSink::console() {
+    static TextRaceSink sink(cout, false);
+    return sink;
+}
+
+RaceEventSink& RaceEventSink::none() {
+    static NullRaceSink sink;
+    return sink;
+}
+
+// ============ TEXT SINK ============
+
+TextRaceSink::TextRaceSink(ostream& out, bool buffered) : out(out), buffered(buffered) {}
+
+TextRaceSink::~TextRaceSink() {
+    flush();
+}
+
+static void appendText(string& text, const RaceEvent& event) {
+    switch (event.type) {
+        case RaceEventType::RaceStart:
+            text += "\n========================================\n";
+            text += "    RACE: " + *event.raceName + "\n";
+            text += "    Drivers: " + to_string(event.value) + "\n";
+            text += "========================================\n";
+            text += "Starting race simulation...\n";
+            break;
+        case RaceEventType::NoDrivers:
+            text += "No drivers in race!\n";
+            break;
+        case RaceEventType::Penalty:
+            text += "  PENALTY: " + event.driver->getName() + " receives 5-second penalty!\n";
+            break;
+        case RaceEventType::Dnf:
+            text += " DNF: " + event.driver->getName() + " did not finish!\n";
+            break;
+        case RaceEventType::FastestLap:
+            text += " FASTEST LAP: " + event.driver->getName() + "\n";
+            break;
+        case RaceEventType::Finish:
+            break;  // The results tables cover finishing order
+        case RaceEventType::RaceEnd:
+            text += "Race completed!\n";
+            break;
+    }
+}
+
+void TextRaceSink::emit(const RaceEvent& event) {
+    if (!buffered) {
+        // No member state, so the shared console sink is safe to share
+        string text;
+        appendText(text, event);
+        if (!text.empty()) out << text << std::flush;
+        return;
+    }
+
+    appendText(buffer, event);
+    if (event.type == RaceEventType::RaceEnd || event.type == RaceEventType::NoDrivers) {
+        flush();
+    }
+}
+
+void TextRaceSink::flush() {
+    if (!buffer.empty()) {
+        out << buffer << std::flush;
+        buffer.clear();
+    }
+}
+
+// ============ BINARY SINK ============
+
+void BinaryRaceSink::putVarint(uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((uint8_t)value);
+}
+
+void BinaryRaceSink::emit(const RaceEvent& event) {
+    int value = event.type == RaceEventType::Finish ? event.points : event.value;
+
+    bytes.push_back((uint8_t)event.type);
+    putVarint(event.slot < 0 ? 0 : (uint64_t)event.slot + 1);
+    // Zigzag keeps small negative values to one byte
+    putVarint(((uint64_t)(int64_t)value << 1) ^ (uint64_t)((int64_t)value >> 63));
+}
+
+const vector<uint8_t>& BinaryRaceSink::getBytes() const {
+    return bytes;
+}
+
+void BinaryRaceSink::clear() {
+    bytes.clear();
+}
@@ -0,0 +1,85 @@
+//
+// Race Event Sinks
+// RaceSimulator reports what happens in a race as structured events; the
+// sink decides whether they become console text, bytes, or nothing
+//
+
+#ifndef F1_FANTASY_DSA_RACEEVENTS_H
+#define F1_FANTASY_DSA_RACEEVENTS_H
+
+#include "../Core/Driver.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+enum class RaceEventType : uint8_t {
+    RaceStart,   // value = number of drivers
+    NoDrivers,
+    Penalty,     // value = position after the penalty
+    Dnf,         // value = position after retiring
+    FastestLap,  // value = position
+    Finish,      // value = position, points = points earned
+    RaceEnd
+};
+
+struct RaceEvent {
+    RaceEventType type;
+    const string* raceName;  // Always set
+    const Driver* driver;    // nullptr for race-level events
+    int slot;                // Driver's index in the race entry list, or -1
+    int value;
+    int points;
+};
+
+class RaceEventSink {
+public:
+    virtual ~RaceEventSink() {}
+    virtual void emit(const RaceEvent& event) = 0;
+
+    // Shared stateless sinks: the console text the game has always shown,
+    // and one that drops everything for bulk runs
+    static RaceEventSink& console();
+    static RaceEventSink& none();
+};
+
+// Drops every event
+class NullRaceSink : public RaceEventSink {
+public:
+    void emit(const RaceEvent&) override {}
+};
+
+// The simulator's classic commentary. Buffered sinks hold a race's text
+// and write it in one go when the race ends.
+class TextRaceSink : public RaceEventSink {
+private:
+    ostream& out;
+    bool buffered;
+    string buffer;
+
+public:
+    TextRaceSink(ostream& out, bool buffered);
+    ~TextRaceSink() override;
+
+    void emit(const RaceEvent& event) override;
+    void flush();
+};
+
+// Records appended to memory: type byte, varint slot + 1 (0 = no driver),
+// varint zigzag value, so any field size and value fit. Finish records
+// carry points instead of position, which is implied by their order.
+class BinaryRaceSink : public RaceEventSink {
+private:
+    vector<uint8_t> bytes;
+
+    void putVarint(uint64_t value);
+
+public:
+    void emit(const RaceEvent& event) override;
+
+    const vector<uint8_t>& getBytes() const;
+    void clear();
+};
+
+#endif //F1_FANTASY_DSA_RACEEVENTS_H
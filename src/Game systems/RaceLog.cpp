@@ -0,0 +1,393 @@
+//
+// Race Replay Log Implementation
+//
+
+#include "RaceLog.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+
+static const char RACE_LOG_MAGIC[8] = {'F', '1', 'R', 'L', 'O', 'G', '\0', '\0'};
+static const size_t RACE_LOG_HEADER_SIZE = sizeof(RACE_LOG_MAGIC) + sizeof(uint32_t);
+
+const uint8_t FLAG_ID = 1;
+const uint8_t FLAG_ENTRANTS = 2;
+
+// 20! is the largest factorial below 2^63
+const size_t MAX_RANKED_ORDER = 20;
+
+// ============ HELPER FUNCTIONS ============
+
+static void putVarint(vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static bool getVarint(const vector<uint8_t>& in, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= in.size()) return false;
+        uint8_t byte = in[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static bool getInt(const vector<uint8_t>& in, size_t& offset, int& value, uint64_t limit) {
+    uint64_t raw;
+    if (!getVarint(in, offset, raw) || raw > limit) return false;
+    value = (int)raw;
+    return true;
+}
+
+// Position p's digit counts the unused slots below order[p]; digits form a
+// mixed-radix number, so every permutation of n gets a rank below n!
+static uint64_t rankOrder(const vector<int>& order) {
+    size_t n = order.size();
+    uint64_t rank = 0;
+    for (size_t p = 0; p < n; p++) {
+        uint64_t digit = 0;
+        for (size_t q = p + 1; q < n; q++) {
+            if (order[q] < order[p]) digit++;
+        }
+        rank = rank * (n - p) + digit;
+    }
+    return rank;
+}
+
+// Appends to a log file, or starts it over with a header when fresh
+static bool writeLogFile(const string& filename, bool fresh, const uint8_t* data, size_t size) {
+    ofstream out(filename, fresh ? ios::binary | ios::trunc : ios::binary | ios::app);
+    if (!out) return false;
+
+    if (fresh) {
+        uint32_t version = RACE_LOG_VERSION;
+        out.write(RACE_LOG_MAGIC, sizeof(RACE_LOG_MAGIC));
+        out.write((const char*)&version, sizeof(version));
+    }
+    out.write((const char*)data, (streamsize)size);
+    out.flush();
+    return out.good();
+}
+
+static bool unrankOrder(uint64_t rank, size_t n, vector<int>& order) {
+    vector<int> digits(n);
+    for (size_t p = n; p-- > 0;) {
+        digits[p] = (int)(rank % (n - p));
+        rank /= (n - p);
+    }
+    if (rank != 0) return false;
+
+    vector<int> unused(n);
+    for (size_t i = 0; i < n; i++) unused[i] = (int)i;
+
+    order.resize(n);
+    for (size_t p = 0; p < n; p++) {
+        order[p] = unused[digits[p]];
+        unused.erase(unused.begin() + digits[p]);
+    }
+    return true;
+}
+
+// ============ CONSTRUCTOR ============
+
+RaceLog::RaceLog(const vector<Driver>* roster)
+    : roster(roster), raceCount(0), savedBytes(0), hasFile(false),
+      haveLast(false), lastSeed(0), lastStream(0), nextRaceNumber(0), recording(false),
+      saveStatus(make_shared<RaceLogSaveStatus>()) {}
+
+// ============ RECORDING ============
+
+void RaceLog::beginRace(uint64_t seed, uint64_t stream, uint64_t raceNumber, int lapCount,
+                        const vector<Driver*>& entrants) {
+    current = RaceRecord();
+    current.seed = seed;
+    current.stream = stream;
+    current.raceNumber = raceNumber;
+    current.lapCount = lapCount;
+
+    for (size_t slot = 0; slot < entrants.size(); slot++) {
+        int index = (int)slot;
+        if (roster != nullptr && !roster->empty() &&
+            entrants[slot] >= roster->data() && entrants[slot] < roster->data() + roster->size()) {
+            index = (int)(entrants[slot] - roster->data());
+        }
+        current.entrants.push_back(index);
+    }
+    recording = true;
+}
+
+void RaceLog::emit(const RaceEvent& event) {
+    if (!recording) return;
+
+    switch (event.type) {
+        case RaceEventType::RaceStart:
+            current.raceName = *event.raceName;
+            break;
+        case RaceEventType::Penalty:
+        case RaceEventType::Dnf:
+            current.incidents.push_back(RaceIncident(event.type, event.slot, event.value));
+            break;
+        case RaceEventType::FastestLap:
+            current.fastestLapSlot = event.slot;
+            break;
+        case RaceEventType::Finish:
+            current.finishingOrder.push_back(event.slot);
+            break;
+        case RaceEventType::RaceEnd:
+            encode(current);
+            recording = false;
+            break;
+        case RaceEventType::NoDrivers:
+            recording = false;
+            break;
+    }
+}
+
+void RaceLog::encode(const RaceRecord& record) {
+    size_t n = record.finishingOrder.size();
+
+    bool implicitId = haveLast && record.seed == lastSeed &&
+                      record.stream == lastStream && record.raceNumber == nextRaceNumber;
+    bool identityEntrants = record.entrants.size() == n;
+    for (size_t i = 0; i < record.entrants.size() && identityEntrants; i++) {
+        identityEntrants = record.entrants[i] == (int)i;
+    }
+
+    uint8_t flags = 0;
+    if (!implicitId) flags |= FLAG_ID;
+    if (!identityEntrants) flags |= FLAG_ENTRANTS;
+    bytes.push_back(flags);
+
+    putVarint(bytes, n);
+    putVarint(bytes, record.lapCount);
+    putVarint(bytes, record.raceName.size());
+    bytes.insert(bytes.end(), record.raceName.begin(), record.raceName.end());
+
+    if (flags & FLAG_ID) {
+        for (int i = 0; i < 8; i++) {
+            bytes.push_back((uint8_t)(record.seed >> (8 * i)));
+        }
+        putVarint(bytes, record.stream);
+        putVarint(bytes, record.raceNumber);
+    }
+
+    if (flags & FLAG_ENTRANTS) {
+        for (int index : record.entrants) {
+            putVarint(bytes, index);
+        }
+    }
+
+    if (n <= MAX_RANKED_ORDER) {
+        putVarint(bytes, rankOrder(record.finishingOrder));
+    } else {
+        for (int slot : record.finishingOrder) {
+            putVarint(bytes, slot);
+        }
+    }
+
+    putVarint(bytes, record.fastestLapSlot + 1);
+    putVarint(bytes, record.incidents.size());
+    for (const RaceIncident& incident : record.incidents) {
+        bytes.push_back((uint8_t)incident.type);
+        putVarint(bytes, incident.slot);
+        putVarint(bytes, incident.value);
+    }
+
+    haveLast = true;
+    lastSeed = record.seed;
+    lastStream = record.stream;
+    nextRaceNumber = record.raceNumber + 1;
+    raceCount++;
+}
+
+// ============ DECODING ============
+
+bool RaceLog::decode(size_t& offset, RaceRecord& record, uint64_t& seed, uint64_t& stream,
+                     uint64_t& nextNumber, bool& haveId) const {
+    if (offset >= bytes.size()) return false;
+    uint8_t flags = bytes[offset++];
+    if (flags & ~(FLAG_ID | FLAG_ENTRANTS)) return false;
+
+    int n;
+    uint64_t nameLength;
+    if (!getInt(bytes, offset, n, 0xFFFF) ||
+        !getInt(bytes, offset, record.lapCount, 0xFFFF) ||
+        !getVarint(bytes, offset, nameLength) || nameLength > bytes.size() - offset) {
+        return false;
+    }
+    record.raceName.assign((const char*)&bytes[offset], nameLength);
+    offset += nameLength;
+
+    if (flags & FLAG_ID) {
+        if (bytes.size() - offset < 8) return false;
+        seed = 0;
+        for (int i = 0; i < 8; i++) {
+            seed |= (uint64_t)bytes[offset++] << (8 * i);
+        }
+        if (!getVarint(bytes, offset, stream) || !getVarint(bytes, offset, nextNumber)) return false;
+        haveId = true;
+    } else if (!haveId) {
+        return false;
+    }
+    record.seed = seed;
+    record.stream = stream;
+    record.raceNumber = nextNumber++;
+
+    record.entrants.resize(n);
+    for (int i = 0; i < n; i++) {
+        record.entrants[i] = i;
+        if ((flags & FLAG_ENTRANTS) && !getInt(bytes, offset, record.entrants[i], 0x7FFFFFFF)) {
+            return false;
+        }
+    }
+
+    if ((size_t)n <= MAX_RANKED_ORDER) {
+        uint64_t rank;
+        if (!getVarint(bytes, offset, rank) || !unrankOrder(rank, n, record.finishingOrder)) {
+            return false;
+        }
+    } else {
+        record.finishingOrder.resize(n);
+        for (int p = 0; p < n; p++) {
+            if (!getInt(bytes, offset, record.finishingOrder[p], n - 1)) return false;
+        }
+    }
+
+    int fastest, incidentCount;
+    if (!getInt(bytes, offset, fastest, n) || !getInt(bytes, offset, incidentCount, 0xFFFF)) {
+        return false;
+    }
+    record.fastestLapSlot = fastest - 1;
+
+    record.incidents.clear();
+    for (int i = 0; i < incidentCount; i++) {
+        if (offset >= bytes.size()) return false;
+        RaceEventType type = (RaceEventType)bytes[offset++];
+        int slot, value;
+        if ((type != RaceEventType::Penalty && type != RaceEventType::Dnf) ||
+            !getInt(bytes, offset, slot, n - 1) || !getInt(bytes, offset, value, 0xFFFF)) {
+            return false;
+        }
+        record.incidents.push_back(RaceIncident(type, slot, value));
+    }
+    return true;
+}
+
+bool RaceLog::read(size_t index, RaceRecord& record) const {
+    if (index >= raceCount) return false;
+
+    // Ids may be implicit, so walk from the start
+    size_t offset = 0;
+    uint64_t seed = 0, stream = 0, nextNumber = 0;
+    bool haveId = false;
+    for (size_t i = 0; i <= index; i++) {
+        if (!decode(offset, record, seed, stream, nextNumber, haveId)) return false;
+    }
+    return true;
+}
+
+// ============ GETTERS ============
+
+size_t RaceLog::getRaceCount() const {
+    return raceCount;
+}
+
+const vector<uint8_t>& RaceLog::getBytes() const {
+    return bytes;
+}
+
+// ============ FILE I/O ============
+
+bool RaceLog::loadFromFile(const string& filename) {
+    bytes.clear();
+    raceCount = 0;
+    savedBytes = 0;
+    hasFile = false;
+    haveLast = false;
+    recording = false;
+
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    uint32_t version;
+    if (file.size() < RACE_LOG_HEADER_SIZE ||
+        memcmp(file.begin(), RACE_LOG_MAGIC, sizeof(RACE_LOG_MAGIC)) != 0) {
+        return false;
+    }
+    memcpy(&version, file.begin() + sizeof(RACE_LOG_MAGIC), sizeof(version));
+    if (version != RACE_LOG_VERSION) return false;
+
+    bytes.assign(file.begin() + RACE_LOG_HEADER_SIZE, file.end());
+
+    // Count races and pick up the generator position for the next record.
+    // A torn final record (crash mid-append) is dropped.
+    size_t offset = 0;
+    uint64_t seed = 0, stream = 0, nextNumber = 0;
+    bool haveId = false;
+    bool torn = false;
+    RaceRecord record;
+    while (offset < bytes.size()) {
+        size_t start = offset;
+        if (!decode(offset, record, seed, stream, nextNumber, haveId)) {
+            bytes.resize(start);
+            torn = true;
+            break;
+        }
+        raceCount++;
+    }
+
+    haveLast = haveId;
+    lastSeed = seed;
+    lastStream = stream;
+    nextRaceNumber = nextNumber;
+
+    // The torn bytes are still in the file, and appending after them would
+    // hide every later race, so the next save rewrites the whole log
+    savedBytes = torn ? 0 : bytes.size();
+    hasFile = !torn;
+    return true;
+}
+
+bool RaceLog::appendToFile(const string& filename) {
+    // Only a file this log was loaded from can take implicit ids, so
+    // anything else is rewritten with a header and the whole log
+    bool fresh = !hasFile;
+    if (!writeLogFile(filename, fresh, bytes.data() + savedBytes, bytes.size() - savedBytes)) {
+        return false;
+    }
+
+    savedBytes = bytes.size();
+    hasFile = true;
+    return true;
+}
+
+function<void()> RaceLog::takeUnsavedWrite(const string& filename) {
+    // A failed write leaves a gap that would shift every implicit id after
+    // it, so start the file over
+    if (saveStatus->failed.exchange(false)) {
+        hasFile = false;
+        savedBytes = 0;
+    }
+
+    bool fresh = !hasFile;
+    vector<uint8_t> pending(bytes.begin() + savedBytes, bytes.end());
+    savedBytes = bytes.size();
+    hasFile = true;
+
+    shared_ptr<RaceLogSaveStatus> status = saveStatus;
+    return [filename, fresh, pending, status]() {
+        if (!writeLogFile(filename, fresh, pending.data(), pending.size())) {
+            status->failed = true;
+            status->unreported = true;
+        }
+    };
+}
+
+bool RaceLog::takeSaveFailure() {
+    return saveStatus->unreported.exchange(false);
+}
@@ -0,0 +1,118 @@
+//
+// Race Replay Log
+// Every simulated race as its seed plus a compact event list, so a race
+// weekend can be reproduced exactly without re-running the simulation
+//
+
+#ifndef F1_FANTASY_DSA_RACELOG_H
+#define F1_FANTASY_DSA_RACELOG_H
+
+#include "../Core/Driver.h"
+#include "RaceEvents.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+const uint32_t RACE_LOG_VERSION = 1;
+
+// A penalty or DNF, with the value its event carried
+struct RaceIncident {
+    RaceEventType type;
+    int slot;
+    int value;
+
+    RaceIncident(RaceEventType t, int s, int v) : type(t), slot(s), value(v) {}
+};
+
+// One logged race
+struct RaceRecord {
+    string raceName;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t raceNumber;          // Races the simulator had run before this one
+    int lapCount;                 // 0 = finishing-order model
+    vector<int> entrants;         // Roster index of each entry slot
+    vector<int> finishingOrder;   // Entry slot in each position
+    int fastestLapSlot;           // -1 if nobody took it
+    vector<RaceIncident> incidents;
+
+    RaceRecord() : seed(0), stream(0), raceNumber(0), lapCount(0), fastestLapSlot(-1) {}
+};
+
+// Outcome of background saves, shared with the writes still pending
+struct RaceLogSaveStatus {
+    atomic<bool> failed;      // The next save must rewrite the file
+    atomic<bool> unreported;  // Not yet handed to the caller
+
+    RaceLogSaveStatus() : failed(false), unreported(false) {}
+};
+
+// Record layout (varints are unsigned LEB128):
+//   flags                  bit 0: id follows, bit 1: entrant list follows
+//   varint driverCount, varint lapCount, varint nameLength, name bytes
+//   [u64 seed, varint stream, varint raceNumber]
+//                          omitted when this race is the next one from the
+//                          previous record's generator
+//   [varint entrant...]    omitted when slots are roster 0..n-1
+//   finishing order        Lehmer-code rank as a varint for up to 20
+//                          drivers (about 4 bytes for 10), else a varint per slot
+//   varint fastestLapSlot + 1
+//   varint incidentCount, then per incident: type byte, varint slot, varint value
+//
+// A season of 10-driver races costs roughly 10 bytes per race.
+class RaceLog : public RaceEventSink {
+private:
+    const vector<Driver>* roster;  // Maps entrants to indices; may be null
+    vector<uint8_t> bytes;
+    size_t raceCount;
+    size_t savedBytes;             // Prefix already in the file
+    bool hasFile;                  // Loaded from, or written to, a file
+
+    // Generator position after the last record, for implicit ids
+    bool haveLast;
+    uint64_t lastSeed;
+    uint64_t lastStream;
+    uint64_t nextRaceNumber;
+
+    RaceRecord current;
+    bool recording;
+
+    shared_ptr<RaceLogSaveStatus> saveStatus;
+
+    void encode(const RaceRecord& record);
+    bool decode(size_t& offset, RaceRecord& record, uint64_t& seed, uint64_t& stream,
+                uint64_t& nextNumber, bool& haveId) const;
+
+public:
+    explicit RaceLog(const vector<Driver>* roster = nullptr);
+
+    // Called by RaceSimulator before a race's first event
+    void beginRace(uint64_t seed, uint64_t stream, uint64_t raceNumber, int lapCount,
+                   const vector<Driver*>& entrants);
+    void emit(const RaceEvent& event) override;
+
+    size_t getRaceCount() const;
+    const vector<uint8_t>& getBytes() const;
+
+    // Decodes race `index` (0 = oldest); false if out of range or corrupt
+    bool read(size_t index, RaceRecord& record) const;
+
+    // The file is a small header followed by records, so new races are
+    // simply appended. Loading replaces the in-memory log.
+    bool loadFromFile(const string& filename);
+    bool appendToFile(const string& filename);
+
+    // Same as appendToFile, but returns the write for another thread to
+    // run; the races it holds count as saved from now on
+    function<void()> takeUnsavedWrite(const string& filename);
+
+    // True once for each background save that failed since the last call;
+    // the writes never print, so the caller reports it
+    bool takeSaveFailure();
+};
+
+#endif //F1_FANTASY_DSA_RACELOG_H
@@ -5,15 +5,23 @@
 #include "RaceSimulator.h"
 #include <iostream>
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RACE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 // ============ CONSTRUCTOR ============
 
-RaceSimulator::RaceSimulator(const string& name) : raceName(name) {
-    srand(time(0));
-}
+RaceSimulator::RaceSimulator(const string& name)
+    : RaceSimulator(name, Random::randomSeed()) {}
+
+RaceSimulator::RaceSimulator(const string& name, uint64_t seed, uint64_t stream)
+    : raceName(name), seed(seed), stream(stream), racesRun(0), rng(seed, stream),
+      sink(&RaceEventSink::console()), log(nullptr), lapCount(0) {}
 
 // ============ SETUP ============
 
@@ -27,87 +35,180 @@ void RaceSimulator::addDriver(Driver* driver) {
 
 void RaceSimulator::runRace() {
     if (drivers.empty()) {
-        cout << "No drivers in race!" << endl;
+        emit(RaceEventType::NoDrivers);
         return;
     }
 
-    cout << "\n========================================" << endl;
-    cout << "    RACE: " << raceName << endl;
-    cout << "    Drivers: " << drivers.size() << endl;
-    cout << "========================================" << endl;
-    cout << "Starting race simulation..." << endl;
+    if (log != nullptr) {
+        log->beginRace(seed, stream, racesRun, lapCount, drivers);
+    }
+    racesRun++;
+
+    emit(RaceEventType::RaceStart, nullptr, drivers.size());
 
-    //  Simulate race positions
-    simulateRacePositions();
+    if (lapCount > 0) {
+        // Events and fastest lap come from the laps themselves
+        simulateLaps();
+    } else {
+        //  Simulate race positions
+        simulateRacePositions();
 
-    //  Apply random events (penalties, DNF, etc.)
-    applyRandomEvents();
+        //  Apply random events (penalties, DNF, etc.)
+        applyRandomEvents();
 
-    //  Assign fastest lap
-    assignFastestLap();
+        //  Assign fastest lap
+        assignFastestLap();
+    }
 
     //  Calculate points
     calculatePoints();
 
-    cout << "Race completed!" << endl;
+    emit(RaceEventType::RaceEnd);
 }
 
-void RaceSimulator::simulateRacePositions() {
+bool RaceSimulator::replayRace(const RaceRecord& record) {
+    size_t n = drivers.size();
+    if (n == 0 || record.finishingOrder.size() != n) return false;
+
+    vector<bool> placed(n, false);
+    for (int slot : record.finishingOrder) {
+        if (slot < 0 || slot >= (int)n || placed[slot]) return false;
+        placed[slot] = true;
+    }
+
+    // Replays are already in the log
+    RaceLog* recording = log;
+    log = nullptr;
+
     raceResults.clear();
+    for (size_t p = 0; p < n; p++) {
+        int slot = record.finishingOrder[p];
+        raceResults.push_back(RaceResult(drivers[slot], p + 1, slot));
+    }
+
+    emit(RaceEventType::RaceStart, nullptr, n);
+    for (const RaceIncident& incident : record.incidents) {
+        RaceResult involved(drivers[incident.slot], incident.value, incident.slot);
+        emit(incident.type, &involved, incident.value);
+    }
+    for (RaceResult& result : raceResults) {
+        if (result.slot == record.fastestLapSlot) {
+            result.fastestLap = true;
+            emit(RaceEventType::FastestLap, &result, result.position);
+        }
+    }
+    calculatePoints();
+    emit(RaceEventType::RaceEnd);
+
+    log = recording;
+    return true;
+}
+
+void RaceSimulator::runRaces(size_t k, RaceBatch& out) {
+    size_t driverCount = drivers.size();
+    out.resize(k, driverCount);
+
+    for (size_t r = 0; r < k; r++) {
+        runRace();
 
-    // Create results with randomized positions
-    // Better drivers (higher current points) have better chance of good positions
-    for (Driver* driver : drivers) {
-        int basePosition = rand() % drivers.size() + 1;
+        int* slots = &out.finisherSlot[r * driverCount];
+        int* points = &out.pointsEarned[r * driverCount];
+        out.fastestLapSlot[r] = -1;
 
-        // Bias towards better positions for higher-rated drivers
-        if (driver->getPoints() > 150) {
-            basePosition = getRandomPosition(drivers.size() / 3);
-        } else if (driver->getPoints() > 100) {
-            basePosition = getRandomPosition(drivers.size() / 2);
+        for (size_t p = 0; p < raceResults.size(); p++) {
+            const RaceResult& result = raceResults[p];
+            slots[p] = result.slot;
+            points[p] = result.pointsEarned;
+            if (result.fastestLap) {
+                out.fastestLapSlot[r] = result.slot;
+            }
         }
+    }
+}
+
+// Plackett-Luce: each driver draws key E / w with E ~ Exp(1). Sorting the
+// keys ascending gives exactly the order of repeatedly picking the next
+// finisher with probability proportional to w, in one pass plus a sort.
+void RaceSimulator::simulateRacePositions() {
+    raceResults.clear();
+    sampleKeys.resize(drivers.size());
+
+    for (size_t slot = 0; slot < drivers.size(); slot++) {
+        float key = (float)(rng.nextExponential() / strengthOf(*drivers[slot]));
 
-        RaceResult result(driver, basePosition);
-        raceResults.push_back(result);
+        // Non-negative floats order like their bit patterns, and the slot in
+        // the low half breaks ties the same way every time
+        uint32_t bits;
+        memcpy(&bits, &key, sizeof(bits));
+        sampleKeys[slot] = ((uint64_t)bits << 32) | slot;
     }
 
-    // Sort by position
-    sort(raceResults.begin(), raceResults.end(),
-         [](const RaceResult& a, const RaceResult& b) {
-             return a.position < b.position;
-         });
+    sortSampleKeys();
+
+    for (size_t i = 0; i < sampleKeys.size(); i++) {
+        uint32_t slot = (uint32_t)sampleKeys[i];
+        raceResults.push_back(RaceResult(drivers[slot], i + 1, slot));
+    }
+}
+
+void RaceSimulator::sortSampleKeys() {
+    size_t n = sampleKeys.size();
+
+    // A real grid is ~20 cars, where insertion sort wins outright
+    if (n <= 64) {
+        for (size_t i = 1; i < n; i++) {
+            uint64_t key = sampleKeys[i];
+            size_t j = i;
+            while (j > 0 && sampleKeys[j - 1] > key) {
+                sampleKeys[j] = sampleKeys[j - 1];
+                j--;
+            }
+            sampleKeys[j] = key;
+        }
+        return;
+    }
 
-    // Ensure unique positions
-    for (int i = 0; i < raceResults.size(); i++) {
-        raceResults[i].position = i + 1;
+    // LSD radix sort on the key bits, one byte per pass; slots are already
+    // in order and every pass is stable
+    sampleBuffer.resize(n);
+    for (int shift = 32; shift < 64; shift += 8) {
+        size_t counts[257] = {0};
+        for (uint64_t key : sampleKeys) {
+            counts[((key >> shift) & 0xFF) + 1]++;
+        }
+        for (int b = 0; b < 256; b++) {
+            counts[b + 1] += counts[b];
+        }
+        for (uint64_t key : sampleKeys) {
+            sampleBuffer[counts[(key >> shift) & 0xFF]++] = key;
+        }
+        sampleKeys.swap(sampleBuffer);
     }
 }
 
 void RaceSimulator::applyRandomEvents() {
     // 20% chance of penalty for random driver
-    if (rand() % 100 < 20) {
-        int penalizedIdx = rand() % raceResults.size();
-        cout << "  PENALTY: " << raceResults[penalizedIdx].driver->getName()
-             << " receives 5-second penalty!" << endl;
+    if (rng.nextBelow(100) < 20) {
+        int penalizedIdx = rng.nextBelow(raceResults.size());
+        const RaceResult penalized = raceResults[penalizedIdx];
 
         // Move driver down positions
+        int newPosition = penalizedIdx + 1;
         if (penalizedIdx < raceResults.size() - 2) {
             swap(raceResults[penalizedIdx], raceResults[penalizedIdx + 2]);
             raceResults[penalizedIdx].position = penalizedIdx + 1;
             raceResults[penalizedIdx + 2].position = penalizedIdx + 3;
+            newPosition = penalizedIdx + 3;
         }
+        emit(RaceEventType::Penalty, &penalized, newPosition);
     }
 
     // 10% chance of DNF for a driver in bottom half
-    if (rand() % 100 < 10 && raceResults.size() > 5) {
-        int dnfIdx = raceResults.size() / 2 + rand() % (raceResults.size() / 2);
-        cout << " DNF: " << raceResults[dnfIdx].driver->getName()
-             << " did not finish!" << endl;
-
+    if (rng.nextBelow(100) < 10 && raceResults.size() > 5) {
+        int dnfIdx = raceResults.size() / 2 + rng.nextBelow(raceResults.size() / 2);
         // Move to last position
-        RaceResult dnfResult = raceResults[dnfIdx];
-        raceResults.erase(raceResults.begin() + dnfIdx);
-        raceResults.push_back(dnfResult);
+        emit(RaceEventType::Dnf, &raceResults[dnfIdx], raceResults.size());
+        rotate(raceResults.begin() + dnfIdx, raceResults.begin() + dnfIdx + 1, raceResults.end());
 
         // Update positions
         for (int i = 0; i < raceResults.size(); i++) {
@@ -117,23 +218,16 @@ void RaceSimulator::applyRandomEvents() {
 }
 
 void RaceSimulator::assignFastestLap() {
+    // Positions are 1..n in order, so P1 always stands in the points and
+    // any non-empty field has a contender
     if (raceResults.empty()) return;
 
-    // Use priority queue to find drivers in points positions
-    priority_queue<RaceResult, vector<RaceResult>, ComparePosition> topDrivers;
-
-    for (const RaceResult& result : raceResults) {
-        if (result.position <= 10) {  // Only top 10 can get fastest lap points
-            topDrivers.push(result);
-        }
-    }
-
     // Higher chance for top 5 drivers to get fastest lap
-    int fastestLapPos = rand() % 5;
+    int fastestLapPos = rng.nextBelow(5);
 
-    if (!topDrivers.empty() && fastestLapPos < raceResults.size()) {
+    if (fastestLapPos < raceResults.size()) {
         raceResults[fastestLapPos].fastestLap = true;
-        cout << " FASTEST LAP: " << raceResults[fastestLapPos].driver->getName() << endl;
+        emit(RaceEventType::FastestLap, &raceResults[fastestLapPos], raceResults[fastestLapPos].position);
     }
 }
 
@@ -157,11 +251,163 @@ void RaceSimulator::calculatePoints() {
         if (result.driver != nullptr) {
             result.driver->addpoints(points);
         }
+
+        emit(RaceEventType::Finish, &result, result.position);
     }
 }
 
-int RaceSimulator::getRandomPosition(int maxPos) {
-    return rand() % maxPos + 1;
+double RaceSimulator::strengthOf(const Driver& driver) {
+    // Form from points scored so far: a 150-point driver is 6x as likely
+    // to lead the field as a pointless one
+    double form = 1.0 + (driver.getPoints() > 0 ? driver.getPoints() : 0) / 100.0;
+    return form * form;
+}
+
+// ============ LAP-BY-LAP MODEL ============
+
+// Seconds. A lap is pace + wear * tyre age + noise; stronger drivers have
+// better pace, and each driver also brings a random form for the day.
+const float BASE_LAP_TIME = 90.0f;
+const float PACE_PER_LOG_STRENGTH = 0.25f;
+const float FORM_SPREAD = 0.8f;
+const float LAP_NOISE = 1.0f;
+const float PIT_LOSS = 20.0f;
+const float PENALTY_SECONDS = 5.0f;
+
+// Per driver per lap: ~6% DNF and ~3% penalty over 60 laps
+const float DNF_CHANCE = 0.001f;
+const float PENALTY_CHANCE = 0.0005f;
+
+// Advances every lane by one lap. Both versions compute the same thing; the
+// SSE2 one does four drivers per step using compare masks as the flags.
+static void advanceLap(LapState& s, size_t lanes) {
+#ifdef RACE_USE_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 dnfChance = _mm_set1_ps(DNF_CHANCE);
+    const __m128 incidentChance = _mm_set1_ps(DNF_CHANCE + PENALTY_CHANCE);
+    const __m128 pitLoss = _mm_set1_ps(PIT_LOSS);
+    const __m128 penaltySeconds = _mm_set1_ps(PENALTY_SECONDS);
+    const __m128 infinity = _mm_set1_ps(INFINITY);
+
+    for (size_t i = 0; i < lanes; i += LapState::LANES) {
+        __m128 running = _mm_loadu_ps(&s.running[i]);
+        __m128 roll = _mm_loadu_ps(&s.roll[i]);
+        __m128 tyreAge = _mm_loadu_ps(&s.tyreAge[i]);
+
+        __m128 retire = _mm_and_ps(_mm_cmplt_ps(roll, dnfChance), running);
+        __m128 penalty = _mm_sub_ps(_mm_and_ps(_mm_cmplt_ps(roll, incidentChance), running), retire);
+        __m128 pitting = _mm_cmpge_ps(tyreAge, _mm_loadu_ps(&s.stint[i]));
+        __m128 still = _mm_sub_ps(running, retire);
+
+        __m128 lapTime = _mm_add_ps(_mm_loadu_ps(&s.pace[i]),
+                                    _mm_mul_ps(_mm_loadu_ps(&s.wear[i]), tyreAge));
+        lapTime = _mm_add_ps(lapTime, _mm_loadu_ps(&s.noise[i]));
+        lapTime = _mm_add_ps(lapTime, _mm_and_ps(pitting, pitLoss));
+
+        __m128 charged = _mm_add_ps(lapTime, _mm_mul_ps(penalty, penaltySeconds));
+        _mm_storeu_ps(&s.totalTime[i], _mm_add_ps(_mm_loadu_ps(&s.totalTime[i]), _mm_mul_ps(still, charged)));
+        _mm_storeu_ps(&s.lapsDone[i], _mm_add_ps(_mm_loadu_ps(&s.lapsDone[i]), still));
+        _mm_storeu_ps(&s.penalties[i], _mm_add_ps(_mm_loadu_ps(&s.penalties[i]), penalty));
+
+        // In-laps don't count towards fastest lap
+        __m128 clean = _mm_andnot_ps(pitting, _mm_cmpgt_ps(still, _mm_setzero_ps()));
+        __m128 candidate = _mm_or_ps(_mm_and_ps(clean, lapTime), _mm_andnot_ps(clean, infinity));
+        _mm_storeu_ps(&s.bestLap[i], _mm_min_ps(_mm_loadu_ps(&s.bestLap[i]), candidate));
+
+        _mm_storeu_ps(&s.tyreAge[i], _mm_andnot_ps(pitting, _mm_add_ps(tyreAge, one)));
+        _mm_storeu_ps(&s.running[i], still);
+    }
+#else
+    for (size_t i = 0; i < lanes; i++) {
+        float retire = s.roll[i] < DNF_CHANCE ? s.running[i] : 0.0f;
+        float penalty = (s.roll[i] < DNF_CHANCE + PENALTY_CHANCE ? s.running[i] : 0.0f) - retire;
+        bool pitting = s.tyreAge[i] >= s.stint[i];
+        float still = s.running[i] - retire;
+
+        float lapTime = s.pace[i] + s.wear[i] * s.tyreAge[i] + s.noise[i] + (pitting ? PIT_LOSS : 0.0f);
+        s.totalTime[i] += still * (lapTime + penalty * PENALTY_SECONDS);
+        s.lapsDone[i] += still;
+        s.penalties[i] += penalty;
+
+        // In-laps don't count towards fastest lap
+        if (still > 0.0f && !pitting && lapTime < s.bestLap[i]) {
+            s.bestLap[i] = lapTime;
+        }
+
+        s.tyreAge[i] = pitting ? 0.0f : s.tyreAge[i] + 1.0f;
+        s.running[i] = still;
+    }
+#endif
+}
+
+void RaceSimulator::simulateLaps() {
+    size_t n = drivers.size();
+    LapState& s = laps;
+    size_t lanes = s.resize(n);
+
+    for (size_t i = 0; i < n; i++) {
+        float form = (float)rng.nextDouble() - 0.5f;
+        s.pace[i] = BASE_LAP_TIME - PACE_PER_LOG_STRENGTH * (float)std::log(strengthOf(*drivers[i]))
+                    + form * FORM_SPREAD;
+        s.wear[i] = 0.04f + 0.04f * (float)rng.nextDouble();
+        s.stint[i] = lapCount * (0.4f + 0.3f * (float)rng.nextDouble());
+        s.bestLap[i] = INFINITY;
+        s.running[i] = 1.0f;
+    }
+
+    for (int lap = 0; lap < lapCount; lap++) {
+        // The generator is serial, so draws come first: one 64-bit word per
+        // driver gives the lap-time noise and the incident roll
+        for (size_t i = 0; i < n; i++) {
+            uint64_t bits = rng.next();
+            s.noise[i] = ((float)(uint32_t)(bits >> 40) * (1.0f / 16777216.0f) - 0.5f) * LAP_NOISE;
+            s.roll[i] = (float)(uint32_t)(bits & 0xFFFFFF) * (1.0f / 16777216.0f);
+        }
+
+        advanceLap(s, lanes);
+    }
+
+    // Classify: finishers by time, then retirements by laps completed. Both
+    // fit in the sampler's packed keys; the exponent bits of +inf and up
+    // sort after every finite time.
+    sampleKeys.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bits;
+        if (s.running[i] > 0.0f) {
+            memcpy(&bits, &s.totalTime[i], sizeof(bits));
+        } else {
+            bits = 0x7F800000u + (uint32_t)(lapCount - (int)s.lapsDone[i]);
+        }
+        sampleKeys[i] = ((uint64_t)bits << 32) | i;
+    }
+    sortSampleKeys();
+
+    raceResults.clear();
+    int fastest = -1;
+    for (size_t p = 0; p < n; p++) {
+        uint32_t slot = (uint32_t)sampleKeys[p];
+        raceResults.push_back(RaceResult(drivers[slot], p + 1, slot));
+
+        if (s.running[slot] > 0.0f && s.bestLap[slot] < INFINITY &&
+            (fastest < 0 || s.bestLap[slot] < s.bestLap[raceResults[fastest].slot])) {
+            fastest = p;
+        }
+    }
+
+    for (const RaceResult& result : raceResults) {
+        for (int k = 0; k < (int)s.penalties[result.slot]; k++) {
+            emit(RaceEventType::Penalty, &result, result.position);
+        }
+    }
+    for (const RaceResult& result : raceResults) {
+        if (s.running[result.slot] == 0.0f) {
+            emit(RaceEventType::Dnf, &result, result.position);
+        }
+    }
+    if (fastest >= 0) {
+        raceResults[fastest].fastestLap = true;
+        emit(RaceEventType::FastestLap, &raceResults[fastest], raceResults[fastest].position);
+    }
 }
 
 // ============ DISPLAY FUNCTIONS ============
@@ -233,7 +479,7 @@ void RaceSimulator::displayDetailedResults() {
 
 // ============ GETTERS ============
 
-vector<RaceResult> RaceSimulator::getResults() const {
+const vector<RaceResult>& RaceSimulator::getResults() const {
     return raceResults;
 }
 
@@ -244,6 +490,10 @@ RaceResult RaceSimulator::getWinner() const {
     return RaceResult(nullptr, 0);
 }
 
+uint64_t RaceSimulator::getSeed() const {
+    return seed;
+}
+
 Driver* RaceSimulator::getFastestLapDriver() const {
     for (const RaceResult& result : raceResults) {
         if (result.fastestLap) {
@@ -258,4 +508,41 @@ Driver* RaceSimulator::getFastestLapDriver() const {
 void RaceSimulator::reset() {
     raceResults.clear();
     drivers.clear();
+}
+
+void RaceSimulator::reseed(uint64_t newSeed, uint64_t newStream) {
+    seed = newSeed;
+    stream = newStream;
+    racesRun = 0;
+    rng = Random(newSeed, newStream);
+}
+
+void RaceSimulator::setLapCount(int count) {
+    lapCount = count > 0 ? count : 0;
+}
+
+int RaceSimulator::getLapCount() const {
+    return lapCount;
+}
+
+void RaceSimulator::setRaceLog(RaceLog* raceLog) {
+    log = raceLog;
+}
+
+void RaceSimulator::setEventSink(RaceEventSink& eventSink) {
+    sink = &eventSink;
+}
+
+void RaceSimulator::emit(RaceEventType type, const RaceResult* result, int value) {
+    RaceEvent event;
+    event.type = type;
+    event.raceName = &raceName;
+    event.driver = result != nullptr ? result->driver : nullptr;
+    event.slot = result != nullptr ? result->slot : -1;
+    event.value = value;
+    event.points = result != nullptr ? result->pointsEarned : 0;
+    sink->emit(event);
+    if (log != nullptr) {
+        log->emit(event);
+    }
 }
\ No newline at end of file
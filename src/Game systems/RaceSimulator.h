@@ -8,8 +8,11 @@
 
 #include "../Core/Driver.h"
 #include "../Core/Constructors.h"
+#include "Random.h"
+#include "RaceEvents.h"
+#include "RaceLog.h"
+#include <cstdint>
 #include <vector>
-#include <queue>
 #include <string>
 using namespace std;
 
@@ -19,23 +22,89 @@ struct RaceResult {
     int position;
     bool fastestLap;
     int pointsEarned;
+    int slot;  // Index in the race's entry list
 
-    RaceResult(Driver* d, int pos)
-        : driver(d), position(pos), fastestLap(false), pointsEarned(0) {}
+    RaceResult(Driver* d, int pos, int s = -1)
+        : driver(d), position(pos), fastestLap(false), pointsEarned(0), slot(s) {}
 };
 
-// Comparator for priority queue (min-heap by position)
-struct ComparePosition {
-    bool operator()(const RaceResult& a, const RaceResult& b) {
-        return a.position > b.position;  // Min heap
+// Results of consecutive races in struct-of-arrays form. Row r is race r and
+// column p is finishing position p + 1. Once reserved for the largest batch,
+// runRaces() reuses the storage and never allocates.
+struct RaceBatch {
+    size_t raceCount;
+    size_t driverCount;
+    vector<int> finisherSlot;    // Entry slot of the driver in each position
+    vector<int> pointsEarned;    // Points scored by that finisher
+    vector<int> fastestLapSlot;  // One per race, -1 if nobody took it
+
+    RaceBatch() : raceCount(0), driverCount(0) {}
+
+    void reserve(size_t races, size_t drivers) {
+        finisherSlot.reserve(races * drivers);
+        pointsEarned.reserve(races * drivers);
+        fastestLapSlot.reserve(races);
+    }
+
+    void resize(size_t races, size_t drivers) {
+        raceCount = races;
+        driverCount = drivers;
+        finisherSlot.resize(races * drivers);
+        pointsEarned.resize(races * drivers);
+        fastestLapSlot.resize(races);
+    }
+
+    const int* slotsOf(size_t race) const { return &finisherSlot[race * driverCount]; }
+    const int* pointsOf(size_t race) const { return &pointsEarned[race * driverCount]; }
+};
+
+// Lap-by-lap state, one array per quantity so a lap is a straight pass
+// over the field. Flags are 0/1 floats so the pass has no branches, and
+// arrays are padded to whole SIMD vectors with lanes that never run.
+struct LapState {
+    static const size_t LANES = 4;
+
+    vector<float> pace;       // Clean-air lap time on new tyres (s)
+    vector<float> wear;       // Time lost per lap of tyre age (s)
+    vector<float> stint;      // Tyre age that triggers a pit stop
+    vector<float> tyreAge;
+    vector<float> totalTime;
+    vector<float> bestLap;
+    vector<float> lapsDone;
+    vector<float> penalties;
+    vector<float> running;
+    vector<float> noise;      // This lap's random draws
+    vector<float> roll;
+
+    // Returns the padded size; padding lanes start (and stay) retired
+    size_t resize(size_t n) {
+        size_t padded = (n + LANES - 1) / LANES * LANES;
+        for (vector<float>* v : {&pace, &wear, &stint, &tyreAge, &totalTime, &bestLap,
+                                 &lapsDone, &penalties, &running, &noise, &roll}) {
+            v->assign(padded, 0.0f);
+        }
+        return padded;
     }
 };
 
 class RaceSimulator {
 private:
     vector<Driver*> drivers;
-    vector<RaceResult> raceResults;
+    vector<RaceResult> raceResults;  // Reused by every race, so capacity sticks
     string raceName;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t racesRun;
+    Random rng;  // Owned, so simulators never share random state
+    RaceEventSink* sink;  // Where commentary goes; never null
+    RaceLog* log;         // Optional record of every race run
+
+    // Finishing-order sampler scratch: (key bits << 32 | slot), reused
+    vector<uint64_t> sampleKeys;
+    vector<uint64_t> sampleBuffer;
+
+    int lapCount;  // 0 = sample the finishing order directly
+    LapState laps;
 
     // F1 points system
     const int POINTS_TABLE[10] = {25, 18, 15, 12, 10, 8, 6, 4, 2, 1};
@@ -46,24 +115,53 @@ private:
     void assignFastestLap();
     void calculatePoints();
     void applyRandomEvents();
-    int getRandomPosition(int basePosition);
+    void sortSampleKeys();
+    void simulateLaps();
+    void emit(RaceEventType type, const RaceResult* result = nullptr, int value = 0);
 
 public:
+    // Plackett-Luce weight: a driver's chance of finishing ahead of the rest
+    // of the field is proportional to this
+    static double strengthOf(const Driver& driver);
+
+    // Without a seed, each simulator draws a fresh one
     RaceSimulator(const string& name);
+    // Same seed, stream and drivers -> the same race, bit for bit
+    RaceSimulator(const string& name, uint64_t seed, uint64_t stream = 0);
 
     // Main operations
     void addDriver(Driver* driver);
     void runRace();
+    // Runs k races back to back, exactly as k runRace() calls would, and
+    // writes them into out. Only getResults() keeps the last race.
+    void runRaces(size_t k, RaceBatch& out);
+    // Rebuilds a logged race without drawing random numbers: same order,
+    // events and points. The entrants must already be added in the logged
+    // slot order. Returns false if the record doesn't fit this field.
+    bool replayRace(const RaceRecord& record);
     void displayResults();
     void displayDetailedResults();
 
     // Getters
-    vector<RaceResult> getResults() const;
+    const vector<RaceResult>& getResults() const;
     RaceResult getWinner() const;
     Driver* getFastestLapDriver() const;
+    uint64_t getSeed() const;
 
     // Utility
     void reset();
+    // Restarts from (seed, stream) as if newly built, keeping drivers,
+    // settings and buffers, so one simulator can run many seasons
+    void reseed(uint64_t newSeed, uint64_t newStream);
+    // Laps > 0 races every lap with pace, tyre wear, pit stops and
+    // incidents; penalties, DNFs and fastest lap come out of the model
+    void setLapCount(int count);
+    int getLapCount() const;
+    // Defaults to the console; RaceEventSink::none() for bulk runs
+    void setEventSink(RaceEventSink& eventSink);
+    // Races run from now on are appended to raceLog (nullptr to stop);
+    // replays are not
+    void setRaceLog(RaceLog* raceLog);
 };
 
 #endif //F1_FANTASY_DSA_RACESIMULATOR_H
\ No newline at end of file
@@ -0,0 +1,37 @@
+//
+// Seedable Random Number Generator Implementation
+//
+
+#include "Random.h"
+#include <chrono>
+#include <random>
+
+// ============ SEEDING ============
+
+static uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Random::Random(uint64_t seed, uint64_t stream) {
+    // Mix the stream in before expanding, so neighbouring streams of one
+    // seed start from unrelated states
+    uint64_t x = seed;
+    uint64_t mixed = splitMix64(x) ^ (stream * 0xD1B54A32D192ED03ULL);
+
+    x = mixed;
+    for (int i = 0; i < 4; i++) {
+        state[i] = splitMix64(x);
+    }
+}
+
+uint64_t Random::randomSeed() {
+    random_device device;
+    uint64_t seed = ((uint64_t)device() << 32) ^ device();
+
+    // random_device may be deterministic on some platforms
+    seed ^= (uint64_t)chrono::high_resolution_clock::now().time_since_epoch().count();
+    return seed;
+}
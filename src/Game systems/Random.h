@@ -0,0 +1,62 @@
+//
+// Seedable Random Number Generator
+// xoshiro256** owned by whoever draws from it, so simulations are
+// reproducible from a seed and never share state across threads
+//
+
+#ifndef F1_FANTASY_DSA_RANDOM_H
+#define F1_FANTASY_DSA_RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+using namespace std;
+
+class Random {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    // Same (seed, stream) -> same sequence. Streams are decorrelated by
+    // seeding through SplitMix64, so e.g. one stream per season or per
+    // thread can be drawn from a single user-visible seed.
+    explicit Random(uint64_t seed, uint64_t stream = 0);
+
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    // Uniform in [0, bound); bound must be > 0
+    uint32_t nextBelow(uint32_t bound) {
+        // Multiply-shift keeps the bias below 2^-32 without a division
+        return (uint32_t)(((next() >> 32) * (uint64_t)bound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double nextDouble() {
+        return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Exponential with rate 1; never returns infinity
+    double nextExponential() {
+        return -log(1.0 - nextDouble());
+    }
+
+    // A fresh seed from the OS, for runs that don't ask for one
+    static uint64_t randomSeed();
+};
+
+#endif //F1_FANTASY_DSA_RANDOM_H
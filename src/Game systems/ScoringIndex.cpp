@@ -0,0 +1,380 @@
+//
+// Race Scoring Index Implementation
+//
+
+#include "ScoringIndex.h"
+#include "ThreadPool.h"
+#include "../Core/Team.h"
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SCORING_USE_AVX2
+#include <immintrin.h>
+#endif
+
+// Below this many items per shard, waking the pool costs more than the work
+const size_t MIN_SHARD_ITEMS = 1 << 16;
+
+// ============ KERNELS ============
+
+// deltas[g] = sum over slots of points[slots[s][g]] for g in [begin, end)
+static void sumRosterPointsScalar(const uint32_t* const* slots, size_t width, const int* points,
+                                  int* deltas, size_t begin, size_t end) {
+    for (size_t g = begin; g < end; g++) {
+        int sum = 0;
+        for (size_t s = 0; s < width; s++) {
+            sum += points[slots[s][g]];
+        }
+        deltas[g] = sum;
+    }
+}
+
+#ifdef SCORING_USE_AVX2
+// Eight rosters per step: one gather per slot, summed in a register.
+// Built for AVX2 on its own so the rest of the program keeps the default
+// target; sumRosterPoints only calls it on CPUs that report AVX2.
+__attribute__((target("avx2")))
+static void sumRosterPointsAvx2(const uint32_t* const* slots, size_t width, const int* points,
+                                int* deltas, size_t begin, size_t end) {
+    size_t g = begin;
+    for (; g + 8 <= end; g += 8) {
+        __m256i sum = _mm256_setzero_si256();
+        for (size_t s = 0; s < width; s++) {
+            __m256i ids = _mm256_loadu_si256((const __m256i*)(slots[s] + g));
+            sum = _mm256_add_epi32(sum, _mm256_i32gather_epi32(points, ids, 4));
+        }
+        _mm256_storeu_si256((__m256i*)(deltas + g), sum);
+    }
+
+    sumRosterPointsScalar(slots, width, points, deltas, g, end);
+}
+
+static bool cpuHasAvx2() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+#endif
+
+static void sumRosterPoints(const uint32_t* const* slots, size_t width, const int* points,
+                            int* deltas, size_t begin, size_t end) {
+#ifdef SCORING_USE_AVX2
+    if (cpuHasAvx2()) {
+        sumRosterPointsAvx2(slots, width, points, deltas, begin, end);
+        return;
+    }
+#endif
+    sumRosterPointsScalar(slots, width, points, deltas, begin, end);
+}
+
+static size_t shardCountFor(size_t items) {
+    size_t limit = ThreadPool::shared().concurrency() * 4;
+    size_t shards = items / MIN_SHARD_ITEMS;
+    if (shards > limit) shards = limit;
+    return shards == 0 ? 1 : shards;
+}
+
+// ============ SIGNATURES ============
+
+size_t TeamSignatureHash::operator()(const vector<uint32_t>& signature) const {
+    // FNV-1a over the ids
+    size_t hash = 14695981039346656037ULL;
+    for (uint32_t id : signature) {
+        hash = (hash ^ id) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// ============ CONSTRUCTOR ============
+
+ScoringIndex::ScoringIndex(const vector<Driver>& drivers, const vector<Constructors>& constructors)
+    : driversBase(drivers.data()), driverCount(drivers.size()), constructorCount(constructors.size()),
+      ownersById(drivers.size() + constructors.size() + 2),
+      pointsById(drivers.size() + constructors.size() + 2, 0),
+      pointsByConstructor(constructors.size(), 0), driverScored(drivers.size(), 0) {
+    constructorIdsByName.reserve(constructors.size());
+    for (size_t i = 0; i < constructors.size(); i++) {
+        constructorIdsByName.emplace(constructors[i].getTeamName(), (uint32_t)i);
+    }
+
+    // Drivers score for the constructor their team name matches
+    driverIdsByName.reserve(drivers.size());
+    constructorOfDriver.reserve(drivers.size());
+    for (size_t i = 0; i < drivers.size(); i++) {
+        driverIdsByName.emplace(drivers[i].getName(), (uint32_t)i);
+
+        auto it = constructorIdsByName.find(drivers[i].getTeam());
+        constructorOfDriver.push_back(it != constructorIdsByName.end() ? it->second : (uint32_t)constructorCount);
+    }
+}
+
+// ============ INDEXING ============
+
+uint32_t ScoringIndex::constructorSlot(uint32_t constructorId) const {
+    return (uint32_t)(driverCount + 1 + constructorId);
+}
+
+uint32_t ScoringIndex::groupFor(vector<uint32_t>& signature) {
+    auto it = groupsBySignature.find(signature);
+    if (it != groupsBySignature.end()) {
+        return it->second;
+    }
+
+    uint32_t group = (uint32_t)groupMembers.size();
+    groupMembers.push_back(vector<uint32_t>());
+
+    // Grow every slot column, widening the matrix if this roster needs it
+    size_t width = signature.size();
+    while (rosterSlots.size() < width) {
+        rosterSlots.push_back(vector<uint32_t>(group, (uint32_t)driverCount));
+    }
+    for (size_t s = 0; s < rosterSlots.size(); s++) {
+        uint32_t id = (uint32_t)driverCount;
+        if (s == 0) {
+            id = constructorSlot(signature[0]);
+        } else if (s < width) {
+            id = signature[s];
+        }
+        rosterSlots[s].push_back(id);
+
+        if (s < width) {
+            ownersById[id].push_back(group);
+        }
+    }
+
+    groupsBySignature.emplace(move(signature), group);
+    return group;
+}
+
+void ScoringIndex::addUser(const User& user) {
+    const Team& team = user.getTeam();
+
+    // Rosters hold copies, so they are matched to ids by name once here
+    vector<uint32_t> signature;
+    auto constructorIt = constructorIdsByName.find(team.getConstructor().getTeamName());
+    signature.push_back(constructorIt != constructorIdsByName.end()
+                            ? constructorIt->second
+                            : (uint32_t)constructorCount);
+
+    for (const Driver& d : team.getDrivers()) {
+        auto it = driverIdsByName.find(d.getName());
+        if (it != driverIdsByName.end()) {
+            signature.push_back(it->second);
+        }
+    }
+
+    // Driver order doesn't change the score, so it isn't part of the team
+    sort(signature.begin() + 1, signature.end());
+
+    uint32_t group = groupFor(signature);
+    groupMembers[group].push_back((uint32_t)groupOfUser.size());
+    groupOfUser.push_back(group);
+}
+
+void ScoringIndex::build(const vector<User*>& users) {
+    groupsBySignature.clear();
+    groupMembers.clear();
+    groupOfUser.clear();
+    rosterSlots.clear();
+    for (vector<uint32_t>& owners : ownersById) {
+        owners.clear();
+    }
+
+    groupOfUser.reserve(users.size());
+    for (const User* user : users) {
+        addUser(*user);
+    }
+}
+
+int ScoringIndex::driverId(const Driver* driver) const {
+    if (driver < driversBase || driver >= driversBase + driverCount) {
+        return -1;
+    }
+    return (int)(driver - driversBase);
+}
+
+size_t ScoringIndex::getUserCount() const {
+    return groupOfUser.size();
+}
+
+size_t ScoringIndex::getGroupCount() const {
+    return groupMembers.size();
+}
+
+const vector<uint32_t>& ScoringIndex::getGroupOfUser() const {
+    return groupOfUser;
+}
+
+// ============ SCORING ============
+
+void ScoringIndex::projectGroupPoints(const vector<int>& driverPoints, vector<int>& groupPoints,
+                                      GroupProjectionScratch& scratch) const {
+    vector<int>& table = scratch.pointsTable;
+    table.assign(pointsById.size(), 0);
+    for (size_t id = 0; id < driverCount && id < driverPoints.size(); id++) {
+        table[id] = driverPoints[id];
+
+        uint32_t constructor = constructorOfDriver[id];
+        if (constructor < constructorCount) {
+            table[constructorSlot(constructor)] += driverPoints[id];
+        }
+    }
+
+    vector<const uint32_t*>& slots = scratch.slots;
+    slots.clear();
+    for (const vector<uint32_t>& slot : rosterSlots) {
+        slots.push_back(slot.data());
+    }
+
+    groupPoints.resize(groupMembers.size());
+    sumRosterPoints(slots.data(), slots.size(), table.data(), groupPoints.data(), 0, groupPoints.size());
+}
+
+size_t ScoringIndex::fillPointsTable(const vector<RaceResult>& results) {
+    fill(pointsById.begin(), pointsById.end(), 0);
+    fill(pointsByConstructor.begin(), pointsByConstructor.end(), 0);
+
+    for (const RaceResult& result : results) {
+        int id = driverId(result.driver);
+        if (id < 0) continue;
+
+        // A driver listed twice only scores their first result
+        if (driverScored[id]) continue;
+        driverScored[id] = 1;
+
+        pointsById[id] = result.pointsEarned;
+
+        uint32_t constructor = constructorOfDriver[id];
+        if (constructor < constructorCount) {
+            pointsByConstructor[constructor] += result.pointsEarned;
+        }
+    }
+
+    for (const RaceResult& result : results) {
+        int id = driverId(result.driver);
+        if (id >= 0) driverScored[id] = 0;
+    }
+
+    for (size_t c = 0; c < constructorCount; c++) {
+        pointsById[constructorSlot((uint32_t)c)] = pointsByConstructor[c];
+    }
+
+    size_t ownerSlots = 0;
+    for (size_t id = 0; id < pointsById.size(); id++) {
+        if (pointsById[id] != 0) {
+            ownerSlots += ownersById[id].size();
+        }
+    }
+    return ownerSlots;
+}
+
+void ScoringIndex::scoreByOwners(vector<User*>& users) {
+    groupDeltas.resize(groupMembers.size(), 0);
+    touchedGroups.clear();
+
+    for (size_t id = 0; id < pointsById.size(); id++) {
+        int points = pointsById[id];
+        if (points == 0) continue;
+
+        for (uint32_t g : ownersById[id]) {
+            if (groupDeltas[g] == 0) {
+                touchedGroups.push_back(g);
+            }
+            groupDeltas[g] += points;
+        }
+    }
+
+    // Fan out to members, reported in user order like a full scan would
+    touchedUsers.clear();
+    for (uint32_t g : touchedGroups) {
+        if (groupDeltas[g] > 0) {
+            touchedUsers.insert(touchedUsers.end(), groupMembers[g].begin(), groupMembers[g].end());
+        }
+    }
+    sort(touchedUsers.begin(), touchedUsers.end());
+
+    for (uint32_t u : touchedUsers) {
+        int points = groupDeltas[groupOfUser[u]];
+        users[u]->addPoints(points);
+        scores.push_back(UserScore(u, points));
+    }
+
+    for (uint32_t g : touchedGroups) {
+        groupDeltas[g] = 0;
+    }
+}
+
+// Each group is summed once, then users are swept in order and pick up their
+// group's delta. Both passes are split into contiguous shards; a user lives
+// in exactly one shard, so shards apply their own points without locking,
+// and concatenating the shard lists in order gives the serial result.
+void ScoringIndex::scoreByMatrix(vector<User*>& users) {
+    size_t groupCount = groupMembers.size();
+    size_t userCount = groupOfUser.size();
+    groupDeltas.resize(groupCount);
+
+    vector<const uint32_t*> slots;
+    for (const vector<uint32_t>& slot : rosterSlots) {
+        slots.push_back(slot.data());
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+
+    size_t groupShards = shardCountFor(groupCount);
+    pool.parallelFor(groupShards, [&](size_t shard) {
+        size_t begin = groupCount * shard / groupShards;
+        size_t end = groupCount * (shard + 1) / groupShards;
+        sumRosterPoints(slots.data(), slots.size(), pointsById.data(), groupDeltas.data(), begin, end);
+    });
+
+    size_t userShards = shardCountFor(userCount);
+    shardScores.resize(userShards > 1 ? userShards : 0);
+
+    pool.parallelFor(userShards, [&](size_t shard) {
+        size_t begin = userCount * shard / userShards;
+        size_t end = userCount * (shard + 1) / userShards;
+
+        // A lone shard writes straight to the result
+        vector<UserScore>& out = userShards == 1 ? scores : shardScores[shard];
+        if (userShards > 1) out.clear();
+
+        for (size_t u = begin; u < end; u++) {
+            int points = groupDeltas[groupOfUser[u]];
+            if (points > 0) {
+                users[u]->addPoints(points);
+                out.push_back(UserScore(u, points));
+            }
+        }
+    });
+
+    if (userShards > 1) {
+        for (const vector<UserScore>& out : shardScores) {
+            scores.insert(scores.end(), out.begin(), out.end());
+        }
+    }
+
+    // The owner walk expects a zeroed column
+    fill(groupDeltas.begin(), groupDeltas.end(), 0);
+}
+
+// The owner walk only visits groups holding a scoring driver but pays for
+// scattered writes and a sort of the touched users; the matrix sweep reads
+// every slot of every group sequentially. Small custom races favour the
+// former, full grids the latter.
+const vector<UserScore>& ScoringIndex::scoreRace(const vector<RaceResult>& results, vector<User*>& users) {
+    scores.clear();
+
+    size_t ownerSlots = fillPointsTable(results);
+    size_t matrixSlots = groupMembers.size() * rosterSlots.size();
+
+    if (ownerSlots * 4 < matrixSlots) {
+        scoreByOwners(users);
+    } else {
+        scoreByMatrix(users);
+    }
+
+    return scores;
+}
+
+const vector<int>& ScoringIndex::getConstructorPoints() const {
+    return pointsByConstructor;
+}
@@ -0,0 +1,118 @@
+//
+// Race Scoring Index
+// Collapses users with identical teams into one roster group, keeps every
+// group both as an inverted index (scoring id -> groups) and as a matrix of
+// fixed-width scoring ids, and scores a race once per group
+//
+
+#ifndef F1_FANTASY_DSA_SCORINGINDEX_H
+#define F1_FANTASY_DSA_SCORINGINDEX_H
+
+#include "../Core/Constructors.h"
+#include "../Core/Driver.h"
+#include "../Core/User.h"
+#include "RaceSimulator.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// A user whose points changed in a race
+struct UserScore {
+    size_t userIndex;
+    int pointsGained;
+
+    UserScore(size_t index, int points) : userIndex(index), pointsGained(points) {}
+};
+
+// Caller-owned buffers for projectGroupPoints, so repeated projections
+// don't allocate
+struct GroupProjectionScratch {
+    vector<int> pointsTable;
+    vector<const uint32_t*> slots;
+};
+
+// Hash for a team signature: constructor id followed by sorted driver ids
+struct TeamSignatureHash {
+    size_t operator()(const vector<uint32_t>& signature) const;
+};
+
+// Drivers and constructors share one id space for scoring, laid out as
+//   [0, driverCount)                      drivers
+//   driverCount                           empty roster slot, always 0 points
+//   driverCount + 1 + constructor id      constructors
+//   driverCount + 1 + constructorCount    unknown constructor, always 0 points
+class ScoringIndex {
+private:
+    // Driver id = position in the drivers vector the index was built for;
+    // constructor ids likewise, with constructorCount meaning unknown
+    const Driver* driversBase;
+    size_t driverCount;
+    size_t constructorCount;
+    unordered_map<string_view, uint32_t> driverIdsByName;
+    unordered_map<string_view, uint32_t> constructorIdsByName;
+    vector<uint32_t> constructorOfDriver;  // Driver id -> constructor id
+
+    // Identical teams share one group and are scored once
+    unordered_map<vector<uint32_t>, uint32_t, TeamSignatureHash> groupsBySignature;
+    vector<vector<uint32_t>> groupMembers;  // Group -> user indices
+    vector<uint32_t> groupOfUser;
+
+    // Scoring id -> groups, once per roster slot holding that id
+    vector<vector<uint32_t>> ownersById;
+
+    // Roster matrix: rosterSlots[s][g] is the scoring id in group g's slot s.
+    // Slot 0 is the constructor; unused driver slots hold driverCount.
+    vector<vector<uint32_t>> rosterSlots;
+
+    // Scratch reused across races
+    vector<int> pointsById;            // Dense over the whole id space
+    vector<int> pointsByConstructor;   // Last race, one per constructor
+    vector<int> groupDeltas;     // One per group
+    vector<uint32_t> touchedGroups;
+    vector<uint32_t> touchedUsers;
+    vector<char> driverScored;
+    vector<UserScore> scores;
+    vector<vector<UserScore>> shardScores;
+
+    uint32_t groupFor(vector<uint32_t>& signature);
+
+    uint32_t constructorSlot(uint32_t constructorId) const;
+
+    // Returns the number of group slots the owner walk would visit
+    size_t fillPointsTable(const vector<RaceResult>& results);
+    void scoreByOwners(vector<User*>& users);
+    void scoreByMatrix(vector<User*>& users);
+
+public:
+    // drivers and constructors must outlive the index and never be resized
+    ScoringIndex(const vector<Driver>& drivers, const vector<Constructors>& constructors);
+
+    // Index the next user's team; users must be added in loadedUsers order
+    void addUser(const User& user);
+    void build(const vector<User*>& users);
+
+    // Position of driver in the indexed vector, or -1
+    int driverId(const Driver* driver) const;
+
+    size_t getUserCount() const;
+    size_t getGroupCount() const;
+    const vector<uint32_t>& getGroupOfUser() const;
+
+    // What each group would score if drivers earned driverPoints (indexed
+    // by driver id), constructor share included. Only touches the caller's
+    // scratch, so several threads may project at once.
+    void projectGroupPoints(const vector<int>& driverPoints, vector<int>& groupPoints,
+                            GroupProjectionScratch& scratch) const;
+
+    // Adds each result's points to the users who own that driver, plus the
+    // driver's constructor total to users who picked that constructor.
+    // Returns the users that gained points, in user index order.
+    const vector<UserScore>& scoreRace(const vector<RaceResult>& results, vector<User*>& users);
+
+    // Points each constructor earned in the last scored race
+    const vector<int>& getConstructorPoints() const;
+};
+
+#endif //F1_FANTASY_DSA_SCORINGINDEX_H
@@ -0,0 +1,291 @@
+//
+// Binary Snapshot Implementation
+//
+
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "../Core/Team.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+static const char SNAPSHOT_MAGIC[8] = {'F', '1', 'S', 'N', 'A', 'P', '\0', '\0'};
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// ============ HELPER FUNCTIONS ============
+
+static uint64_t alignTo8(uint64_t n) {
+    return (n + 7) & ~(uint64_t)7;
+}
+
+static SnapshotString addString(vector<char>& table, const string& s) {
+    SnapshotString ref;
+    ref.offset = (uint32_t)table.size();
+    ref.length = (uint32_t)s.size();
+    table.insert(table.end(), s.begin(), s.end());
+    return ref;
+}
+
+static void writePadding(ofstream& out, uint64_t from, uint64_t to) {
+    static const char zeros[8] = {0};
+    if (to > from) out.write(zeros, (streamsize)(to - from));
+}
+
+// A section fits if it lies inside the file and is aligned for its records
+static bool sectionFits(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize) {
+    if (offset % 8 != 0 || offset > fileSize) return false;
+    return count <= (fileSize - offset) / recordSize;
+}
+
+// ============ WRITE ============
+
+bool Snapshot::write(const string& filename,
+                     const vector<Driver>& drivers,
+                     const vector<Constructors>& constructors,
+                     const vector<User*>& users) {
+    vector<char> strings;
+    vector<DriverRecord> driverRecords;
+    vector<ConstructorRecord> constructorRecords;
+    vector<UserRecord> userRecords;
+    vector<int32_t> roster;
+
+    // Users reference drivers and constructors by index, not by name
+    unordered_map<string_view, int32_t> driverIndex;
+    unordered_map<string_view, int32_t> constructorIndex;
+
+    driverRecords.reserve(drivers.size());
+    for (size_t i = 0; i < drivers.size(); i++) {
+        const Driver& d = drivers[i];
+        DriverRecord record;
+        record.code = addString(strings, d.getCode());
+        record.name = addString(strings, d.getName());
+        record.team = addString(strings, d.getTeam());
+        record.points = d.getPoints();
+        record.price = d.getPrice();
+        record.avgFinishes = d.getAvgFinishes();
+        record.wins = d.getWins();
+        record.podiums = d.getPodiums();
+        driverRecords.push_back(record);
+        driverIndex.emplace(d.getName(), (int32_t)i);
+    }
+
+    constructorRecords.reserve(constructors.size());
+    for (size_t i = 0; i < constructors.size(); i++) {
+        const Constructors& c = constructors[i];
+        ConstructorRecord record;
+        record.code = addString(strings, c.getCode());
+        record.teamName = addString(strings, c.getTeamName());
+        record.price = c.getPrice();
+        record.points = c.getPoints();
+        constructorRecords.push_back(record);
+        constructorIndex.emplace(c.getTeamName(), (int32_t)i);
+    }
+
+    userRecords.reserve(users.size());
+    for (const User* user : users) {
+        const Team& team = user->getTeam();
+
+        UserRecord record;
+        record.username = addString(strings, user->getUsername());
+        record.budget = user->getBudget();
+        record.points = user->getPoints();
+
+        auto constructorIt = constructorIndex.find(team.getConstructor().getTeamName());
+        record.constructorIndex = constructorIt != constructorIndex.end() ? constructorIt->second : -1;
+
+        record.rosterStart = (uint32_t)roster.size();
+        for (const Driver& d : team.getDrivers()) {
+            auto driverIt = driverIndex.find(d.getName());
+            if (driverIt != driverIndex.end()) {
+                roster.push_back(driverIt->second);
+            }
+        }
+        record.rosterCount = (uint32_t)roster.size() - record.rosterStart;
+        userRecords.push_back(record);
+    }
+
+    // Lay out sections
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.driverCount = (uint32_t)driverRecords.size();
+    header.constructorCount = (uint32_t)constructorRecords.size();
+    header.userCount = (uint32_t)userRecords.size();
+    header.rosterCount = (uint32_t)roster.size();
+
+    header.driversOffset = alignTo8(sizeof(SnapshotHeader));
+    header.constructorsOffset = alignTo8(header.driversOffset + driverRecords.size() * sizeof(DriverRecord));
+    header.usersOffset = alignTo8(header.constructorsOffset + constructorRecords.size() * sizeof(ConstructorRecord));
+    header.rosterOffset = alignTo8(header.usersOffset + userRecords.size() * sizeof(UserRecord));
+    header.stringsOffset = alignTo8(header.rosterOffset + roster.size() * sizeof(int32_t));
+    header.stringsSize = strings.size();
+
+    string tempName = filename + ".tmp";
+    error_code ec;
+    {
+        ofstream out(tempName, ios::binary | ios::trunc);
+        if (!out.is_open()) return false;
+
+        out.write((const char*)&header, sizeof(header));
+        writePadding(out, sizeof(header), header.driversOffset);
+
+        out.write((const char*)driverRecords.data(), (streamsize)(driverRecords.size() * sizeof(DriverRecord)));
+        writePadding(out, header.driversOffset + driverRecords.size() * sizeof(DriverRecord), header.constructorsOffset);
+
+        out.write((const char*)constructorRecords.data(), (streamsize)(constructorRecords.size() * sizeof(ConstructorRecord)));
+        writePadding(out, header.constructorsOffset + constructorRecords.size() * sizeof(ConstructorRecord), header.usersOffset);
+
+        out.write((const char*)userRecords.data(), (streamsize)(userRecords.size() * sizeof(UserRecord)));
+        writePadding(out, header.usersOffset + userRecords.size() * sizeof(UserRecord), header.rosterOffset);
+
+        out.write((const char*)roster.data(), (streamsize)(roster.size() * sizeof(int32_t)));
+        writePadding(out, header.rosterOffset + roster.size() * sizeof(int32_t), header.stringsOffset);
+
+        out.write(strings.data(), (streamsize)strings.size());
+
+        // Some write errors only surface when the buffer is flushed on close
+        out.close();
+        if (out.fail()) {
+            filesystem::remove(tempName, ec);
+            return false;
+        }
+    }
+
+    filesystem::rename(tempName, filename, ec);
+    if (ec) {
+        error_code ignored;
+        filesystem::remove(tempName, ignored);
+        return false;
+    }
+    return true;
+}
+
+// ============ LOAD ============
+
+bool Snapshot::load(const string& filename,
+                    vector<Driver>& drivers,
+                    vector<Constructors>& constructors,
+                    vector<User*>& users) {
+    MappedFile file;
+    if (!file.open(filename) || file.size() < sizeof(SnapshotHeader)) return false;
+
+    const char* base = file.begin();
+    uint64_t fileSize = file.size();
+
+    SnapshotHeader header;
+    memcpy(&header, base, sizeof(header));
+
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK) {
+        return false;
+    }
+
+    if (!sectionFits(header.driversOffset, header.driverCount, sizeof(DriverRecord), fileSize) ||
+        !sectionFits(header.constructorsOffset, header.constructorCount, sizeof(ConstructorRecord), fileSize) ||
+        !sectionFits(header.usersOffset, header.userCount, sizeof(UserRecord), fileSize) ||
+        !sectionFits(header.rosterOffset, header.rosterCount, sizeof(int32_t), fileSize) ||
+        header.stringsOffset > fileSize || header.stringsSize > fileSize - header.stringsOffset) {
+        return false;
+    }
+
+    // Pointer fix-ups: every section is used in place from the mapping
+    const DriverRecord* driverRecords = (const DriverRecord*)(base + header.driversOffset);
+    const ConstructorRecord* constructorRecords = (const ConstructorRecord*)(base + header.constructorsOffset);
+    const UserRecord* userRecords = (const UserRecord*)(base + header.usersOffset);
+    const int32_t* roster = (const int32_t*)(base + header.rosterOffset);
+    const char* strings = base + header.stringsOffset;
+
+    bool valid = true;
+    auto resolve = [&](SnapshotString ref) -> string {
+        if ((uint64_t)ref.offset + ref.length > header.stringsSize) {
+            valid = false;
+            return string();
+        }
+        return string(strings + ref.offset, ref.length);
+    };
+
+    vector<Driver> loadedDrivers;
+    loadedDrivers.reserve(header.driverCount);
+    for (uint32_t i = 0; i < header.driverCount; i++) {
+        const DriverRecord& r = driverRecords[i];
+        loadedDrivers.push_back(Driver(resolve(r.code), resolve(r.name), resolve(r.team),
+                                       r.points, r.price, r.avgFinishes, r.wins, r.podiums));
+    }
+
+    vector<Constructors> loadedConstructors;
+    loadedConstructors.reserve(header.constructorCount);
+    for (uint32_t i = 0; i < header.constructorCount; i++) {
+        const ConstructorRecord& r = constructorRecords[i];
+        Constructors c(resolve(r.code), resolve(r.teamName), r.price);
+        c.addpoints(r.points);
+        loadedConstructors.push_back(c);
+    }
+
+    if (!valid) return false;
+
+    // Used if constructor not found
+    const Constructors unknownConstructor("UNK", "Unknown", 10.0);
+
+    vector<User*> loadedUsers;
+    loadedUsers.reserve(header.userCount);
+    for (uint32_t i = 0; i < header.userCount && valid; i++) {
+        const UserRecord& r = userRecords[i];
+
+        if (r.constructorIndex >= (int32_t)header.constructorCount ||
+            (uint64_t)r.rosterStart + r.rosterCount > header.rosterCount) {
+            valid = false;
+            break;
+        }
+
+        Team team(r.budget, r.constructorIndex >= 0 ? loadedConstructors[r.constructorIndex]
+                                                    : unknownConstructor);
+        for (uint32_t j = 0; j < r.rosterCount; j++) {
+            int32_t driverIdx = roster[r.rosterStart + j];
+            if (driverIdx < 0 || driverIdx >= (int32_t)header.driverCount) {
+                valid = false;
+                break;
+            }
+            team.addDriver(loadedDrivers[driverIdx]);
+        }
+
+        User* user = new User(resolve(r.username), r.budget, move(team));
+        user->setPoints(r.points);
+        loadedUsers.push_back(user);
+    }
+
+    if (!valid) {
+        for (User* user : loadedUsers) {
+            delete user;
+        }
+        return false;
+    }
+
+    drivers = move(loadedDrivers);
+    constructors = move(loadedConstructors);
+    users = move(loadedUsers);
+    return true;
+}
+
+// ============ FRESHNESS ============
+
+bool Snapshot::isNewerThan(const string& filename, const vector<string>& sourceFiles) {
+    error_code ec;
+    auto snapshotTime = filesystem::last_write_time(filename, ec);
+    if (ec) return false;
+
+    for (const string& source : sourceFiles) {
+        auto sourceTime = filesystem::last_write_time(source, ec);
+        if (ec) continue;  // Missing sources can't be newer
+
+        // Equal stamps are common on coarse-grained filesystems when the
+        // snapshot is written right after the CSVs, so only a strictly newer
+        // source invalidates it
+        if (sourceTime > snapshotTime) return false;
+    }
+    return true;
+}
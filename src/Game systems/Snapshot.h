@@ -0,0 +1,93 @@
+//
+// Binary Snapshot for Fast Cold Start
+// Fixed-width records plus a string table, loaded with a single mmap
+//
+
+#ifndef F1_FANTASY_DSA_SNAPSHOT_H
+#define F1_FANTASY_DSA_SNAPSHOT_H
+
+#include "../Core/Driver.h"
+#include "../Core/Constructors.h"
+#include "../Core/User.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+const uint32_t SNAPSHOT_VERSION = 1;
+
+// File layout (all sections 8-byte aligned, little-endian):
+//   SnapshotHeader
+//   DriverRecord[driverCount]
+//   ConstructorRecord[constructorCount]
+//   UserRecord[userCount]
+//   int32_t roster[rosterCount]      driver indices, per user
+//   char strings[stringsSize]        referenced by SnapshotString
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t driverCount;
+    uint32_t constructorCount;
+    uint32_t userCount;
+    uint32_t rosterCount;
+    uint64_t driversOffset;
+    uint64_t constructorsOffset;
+    uint64_t usersOffset;
+    uint64_t rosterOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct DriverRecord {
+    SnapshotString code;
+    SnapshotString name;
+    SnapshotString team;
+    int32_t points;
+    float price;
+    int32_t avgFinishes;
+    int32_t wins;
+    int32_t podiums;
+};
+
+struct ConstructorRecord {
+    SnapshotString code;
+    SnapshotString teamName;
+    float price;
+    int32_t points;
+};
+
+struct UserRecord {
+    SnapshotString username;
+    float budget;
+    int32_t points;
+    int32_t constructorIndex;  // -1 = unknown constructor
+    uint32_t rosterStart;
+    uint32_t rosterCount;
+};
+
+class Snapshot {
+public:
+    // Writes via a temp file + rename so readers never see a torn snapshot
+    static bool write(const string& filename,
+                      const vector<Driver>& drivers,
+                      const vector<Constructors>& constructors,
+                      const vector<User*>& users);
+
+    // Returns false (and leaves the vectors empty) if the file is missing,
+    // from another version or fails validation
+    static bool load(const string& filename,
+                     vector<Driver>& drivers,
+                     vector<Constructors>& constructors,
+                     vector<User*>& users);
+
+    // True if the snapshot exists and no source file was modified after it
+    static bool isNewerThan(const string& filename, const vector<string>& sourceFiles);
+};
+
+#endif //F1_FANTASY_DSA_SNAPSHOT_H
@@ -0,0 +1,120 @@
+//
+// Thread Pool Implementation
+//
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency();
+    }
+
+    // The caller of parallelFor is one of the threads
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        stopping = true;
+    }
+    tasksChanged.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::concurrency() const {
+    return workers.size() + 1;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// ============ TASKS ============
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(tasksMutex);
+            tasksChanged.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;  // Stopping and drained
+
+            task = move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        tasks.push_back(move(task));
+    }
+    tasksChanged.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body) {
+    if (count == 0) return;
+
+    if (count == 1 || workers.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    // Helpers may start after every index is claimed (even after we return),
+    // so the bookkeeping is shared and body is only touched while work remains
+    struct LoopState {
+        atomic<size_t> next;
+        size_t count;
+        size_t completed;
+        const function<void(size_t)>* body;
+        mutex doneMutex;
+        condition_variable allDone;
+    };
+
+    shared_ptr<LoopState> state = make_shared<LoopState>();
+    state->next = 0;
+    state->count = count;
+    state->completed = 0;
+    state->body = &body;
+
+    // Each runner claims indices until none are left, so uneven items
+    // balance themselves across threads
+    auto runner = [](LoopState& s) {
+        size_t i;
+        while ((i = s.next.fetch_add(1)) < s.count) {
+            (*s.body)(i);
+
+            lock_guard<mutex> lock(s.doneMutex);
+            if (++s.completed == s.count) {
+                s.allDone.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = count - 1 < workers.size() ? count - 1 : workers.size();
+    for (size_t h = 0; h < helpers; h++) {
+        submit([state, runner]() { runner(*state); });
+    }
+
+    // The caller drains whatever the helpers haven't claimed, so this never
+    // depends on a helper getting scheduled
+    runner(*state);
+
+    unique_lock<mutex> lock(state->doneMutex);
+    state->allDone.wait(lock, [&] { return state->completed == state->count; });
+}
@@ -0,0 +1,48 @@
+//
+// Fixed-size Thread Pool
+// Shared worker threads for parallel loading, scoring and simulation
+//
+
+#ifndef F1_FANTASY_DSA_THREADPOOL_H
+#define F1_FANTASY_DSA_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+class ThreadPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    mutex tasksMutex;
+    condition_variable tasksChanged;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    // threadCount = 0 uses every hardware thread
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that run work, including the calling thread
+    size_t concurrency() const;
+
+    void submit(function<void()> task);
+
+    // Runs body(i) for every i in [0, count) and returns when all are done.
+    // The calling thread works too, so nested calls can't deadlock.
+    void parallelFor(size_t count, const function<void(size_t)>& body);
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared();
+};
+
+#endif //F1_FANTASY_DSA_THREADPOOL_H
@@ -1,12 +1,14 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <limits>
-#include <cstdlib>
-#include <ctime>
 #include <algorithm>
 #include <iomanip>
+#include <unordered_map>
+#include <string_view>
+#include <filesystem>
+#include <memory>
+#include <chrono>
 
 
 #include "../Core/Constructors.h"
@@ -18,6 +20,15 @@
 #include "../dsa/Trie.h"
 #include "RaceSimulator.h"
 #include "Leaderboard.h"
+#include "MappedFile.h"
+#include "CsvReader.h"
+#include "Snapshot.h"
+#include "PointsJournal.h"
+#include "ThreadPool.h"
+#include "ScoringIndex.h"
+#include "ConstructorStandings.h"
+#include "MonteCarloSeason.h"
+#include "RaceLog.h"
 
 
 using namespace std;
@@ -30,13 +41,22 @@ vector<User*> LoadUsersFromCSV(string filename, const vector<Driver>& drivers, c
 Driver SelectDriver(const vector<Driver> &drivers);
 Constructors SelectConstructor(const vector<Constructors> &constructors);
 
-//Storing user team when created fucntion
-bool StoreUserTeam(string filename, User user);
-
 //Updating file functions
 bool UpdateDriversCSV(string filename, const vector<Driver>& drivers);
+bool UpdateConstructorsCSV(string filename, const vector<Constructors>& constructors);
 bool UpdateUsersCSV(string filename, const vector<User*>& users);
-void updateUserPointsFromRace(vector<User*>& users, const vector<RaceResult>& results, Leaderboard& leaderboard);
+bool ReplaceFile(const string& tempName, const string& filename);
+void SaveSnapshot(const vector<Driver>& drivers, const vector<Constructors>& constructors, const vector<User*>& users);
+
+//Journal functions
+void JournalRace(PointsJournal& journal, const string& raceName, const vector<RaceResult>& results, const vector<Driver>& drivers);
+void CompactJournal(PointsJournal& journal, const vector<Driver>& drivers, const vector<Constructors>& constructors,
+                    const vector<User*>& users, bool wait);
+int ScoreRace(ScoringIndex& scoring, ConstructorStandings& standings, PointsJournal& journal,
+              const vector<RaceResult>& results, const vector<Constructors>& constructors,
+              vector<User*>& users, bool verbose);
+void SaveRaceLog(PointsJournal& journal, RaceLog& raceLog);
+void ReportWriterFailures(PointsJournal& journal, RaceLog& raceLog);
 
 //Display functions
 void displaySortingMenu(vector<Driver>& drivers, vector<Constructors>& constructors);
@@ -45,25 +65,49 @@ void displayLeaderboardMenu(Leaderboard& leaderboard, vector<User*>& loadedUsers
 void displayMainMenu();
 
 int main() {
-    srand(time(0));
-
-    // Load data - points are now loaded from CSV
-    vector<Driver> drivers = LoadDrivers("../data/drivers.csv");
-    vector<Constructors> constructors = LoadConstructors("../data/constructors.csv");
+    vector<Driver> drivers;
+    vector<Constructors> constructors;
+    vector<User*> loadedUsers;
+
+    // Prefer the binary snapshot when no CSV has been edited since it was written
+    if (Snapshot::isNewerThan("../data/snapshot.bin",
+                              {"../data/drivers.csv", "../data/constructors.csv", "../data/users.csv"}) &&
+        Snapshot::load("../data/snapshot.bin", drivers, constructors, loadedUsers)) {
+        cout << "Loaded " << drivers.size() << " drivers and " << loadedUsers.size()
+             << " users from snapshot." << endl;
+    } else {
+        // Load data - points are now loaded from CSV
+        drivers = LoadDrivers("../data/drivers.csv");
+        constructors = LoadConstructors("../data/constructors.csv");
 
-    cout << "Loaded " << drivers.size() << " drivers with their points from CSV." << endl;
+        cout << "Loaded " << drivers.size() << " drivers with their points from CSV." << endl;
 
-    // Load users from CSV
-    vector<User*> loadedUsers = LoadUsersFromCSV("../data/users.csv", drivers, constructors);
-    cout << "Loaded " << loadedUsers.size() << " users from CSV." << endl;
+        // Load users from CSV
+        loadedUsers = LoadUsersFromCSV("../data/users.csv", drivers, constructors);
+        cout << "Loaded " << loadedUsers.size() << " users from CSV." << endl;
 
-    // NEW: Create and populate AVL Tree
-    AVLTree avlTree;
+        SaveSnapshot(drivers, constructors, loadedUsers);
+    }
 
-    for (Driver& d : drivers) {
-        avlTree.insert(d);
+    // Apply race results recorded since the CSVs were last compacted
+    PointsJournal journal("../data/points.journal");
+    int replayed = journal.replay(drivers, constructors, loadedUsers);
+    if (replayed > 0) {
+        cout << "Replayed " << replayed << " journal records." << endl;
     }
 
+    // Owners of each driver, so races are scored without scanning every roster
+    ScoringIndex scoring(drivers, constructors);
+
+    // Constructor table kept in order as races add points
+    ConstructorStandings standings(constructors);
+    scoring.build(loadedUsers);
+
+    // NEW: Create and populate AVL Tree
+    // The tree ranks the drivers in place, so `drivers` stays its size from here
+    AVLTree avlTree(drivers);
+    avlTree.rebuild();
+
 
     // After building AVL tree, add:
     Trie driverTrie;
@@ -81,10 +125,19 @@ int main() {
         leaderboard.addUser(user);
     }
 
+    // Reuse last session's ranking order if nothing changed since it was saved
+    leaderboard.loadFromFile("../data/leaderboard.txt");
+
+    // Every scored race, so disputes can be settled by replaying it
+    RaceLog raceLog(&drivers);
+    if (!raceLog.loadFromFile("../data/races.log") && filesystem::exists("../data/races.log")) {
+        cout << "Warning: ../data/races.log is unreadable; a new race log will replace it" << endl;
+    }
 
 
     // Main program loop
     while (true) {
+        ReportWriterFailures(journal, raceLog);
         displayMainMenu();
 
         int choice;
@@ -173,7 +226,9 @@ int main() {
                 }
                 cout << "Total Team Cost: " << teamCost << "M / " << budget << "M" << endl;
 
-                StoreUserTeam("../data/users.csv", *user);
+                scoring.addUser(*user);
+                journal.recordNewTeam(loadedUsers.size() - 1, *user);
+                journal.commit();
 
                 leaderboard.addUser(user);
                 cout << " Team added to leaderboard!" << endl;
@@ -293,11 +348,14 @@ int main() {
                 // Race Simulation
                 int raceChoice;
                 do {
+                    ReportWriterFailures(journal, raceLog);
                     cout << "\n=== RACE SIMULATION ===" << endl;
                     cout << "1. Quick Race (All Drivers)" << endl;
                     cout << "2. Custom Race (Select Drivers)" << endl;
                     cout << "3. Season Simulation (Multiple Races)" << endl;
-                    cout << "4. Back to Main Menu" << endl;
+                    cout << "4. Championship Projection (Monte Carlo)" << endl;
+                    cout << "5. Replay Logged Race (Audit)" << endl;
+                    cout << "6. Back to Main Menu" << endl;
                     cout << "Choose option: ";
 
                     cin >> raceChoice;
@@ -311,6 +369,7 @@ int main() {
                             getline(cin, raceName);
 
                             RaceSimulator race(raceName);
+                            race.setRaceLog(&raceLog);
 
                             // Add all drivers
                             for (Driver& d : drivers) {
@@ -319,67 +378,40 @@ int main() {
 
                             // Run the race
                             race.runRace();
+                            SaveRaceLog(journal, raceLog);
                             race.displayDetailedResults();
 
                             // Track performance for each driver
-                            vector<RaceResult> results = race.getResults();
+                            const vector<RaceResult>& results = race.getResults();
 
                             // Update user points based on their drivers' performance
                             cout << "\n Updating user points based on driver performance..." << endl;
-                            int usersUpdated = 0;
-                            for (User* user : loadedUsers) {
-                                int userPointsGained = 0;
-                                vector<Driver> userDrivers = user->getTeam().getDrivers();
-
-                                // Check each of the user's drivers
-                                for (const Driver& userDriver : userDrivers) {
-                                    // Find this driver in the race results
-                                    for (const RaceResult& result : results) {
-                                        if (result.driver != nullptr &&
-                                            result.driver->getName() == userDriver.getName()) {
-                                            userPointsGained += result.pointsEarned;
-                                            break;
-                                            }
-                                    }
-                                }
-
-                                if (userPointsGained > 0) {
-                                    user->addPoints(userPointsGained);
-                                    cout << "  " << user->getUsername() << ": +" << userPointsGained
-                                         << " points (Total: " << user->getPoints() << ")" << endl;
-                                    usersUpdated++;
-                                }
-                            }
+                            JournalRace(journal, raceName, results, drivers);
+                            int usersUpdated = ScoreRace(scoring, standings, journal, results, constructors, loadedUsers, true);
 
                             if (usersUpdated > 0) {
 
                                 // Update leaderboard
-                                leaderboard.clear();
-                                for (User* user : loadedUsers) {
-                                    leaderboard.addUser(user);
-                                }
+                                leaderboard.invalidateRankings();
                                 cout << " Leaderboard updated!" << endl;
-
-                                // Save to CSV
-                                if (UpdateUsersCSV("../data/users.csv", loadedUsers)) {
-                                    cout << " User points saved to CSV!" << endl;
-                                }
                             } else {
                                 cout << "ℹ  No users had drivers in this race" << endl;
                             }
 
-                            // Update CSV after race
-                            if (UpdateDriversCSV("../data/drivers.csv", drivers)) {
-                                cout << " Driver points updated in CSV file!" << endl;
+                            // Append this race's point changes to the journal
+                            if (journal.commit()) {
+                                cout << " Driver and user points saved to journal!" << endl;
                             } else {
-                                cout << " Failed to update CSV file!" << endl;
+                                cout << " Failed to write points journal!" << endl;
                             }
+                            CompactJournal(journal, drivers, constructors, loadedUsers, false);
 
-                            // Rebuild AVL tree with updated points
-                            cout << "Rebuilding AVL tree with updated points..." << endl;
-                            avlTree.clear();
-                            for (Driver& dr : drivers) {
-                                avlTree.insert(dr);
+                            // Re-key only the drivers who scored
+                            cout << "Updating AVL tree with new points..." << endl;
+                            for (const RaceResult& result : results) {
+                                if (result.pointsEarned != 0) {
+                                    avlTree.update((uint32_t)(result.driver - drivers.data()));
+                                }
                             }
                             cout << "AVL tree updated!" << endl;
 
@@ -398,6 +430,7 @@ int main() {
                             getline(cin, raceName);
 
                             RaceSimulator race(raceName);
+                            race.setRaceLog(&raceLog);
 
                             cout << "\nSelect drivers for the race:" << endl;
                             cout << "Available drivers:" << endl;
@@ -427,65 +460,40 @@ int main() {
                             cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
                             race.runRace();
+                            SaveRaceLog(journal, raceLog);
                             race.displayDetailedResults();
 
                             // Track performance for each driver
-                            vector<RaceResult> results = race.getResults();
+                            const vector<RaceResult>& results = race.getResults();
 
                             // Update user points based on their drivers' performance
                             cout << "\n Updating user points based on driver performance..." << endl;
-                            int usersUpdated = 0;
-                            for (User* user : loadedUsers) {
-                                int userPointsGained = 0;
-                                vector<Driver> userDrivers = user->getTeam().getDrivers();
-
-                                // Check each of the user's drivers
-                                for (const Driver& userDriver : userDrivers) {
-                                    // Find this driver in the race results
-                                    for (const RaceResult& result : results) {
-                                        if (result.driver != nullptr &&
-                                            result.driver->getName() == userDriver.getName()) {
-                                            userPointsGained += result.pointsEarned;
-                                            break;
-                                            }
-                                    }
-                                }
-
-                                if (userPointsGained > 0) {
-                                    user->addPoints(userPointsGained);
-                                    usersUpdated++;
-                                }
-                            }
+                            JournalRace(journal, raceName, results, drivers);
+                            int usersUpdated = ScoreRace(scoring, standings, journal, results, constructors, loadedUsers, false);
 
                             if (usersUpdated > 0) {
 
                                 // Update leaderboard
-                                leaderboard.clear();
-                                for (User* user : loadedUsers) {
-                                    leaderboard.addUser(user);
-                                }
+                                leaderboard.invalidateRankings();
                                 cout << " Leaderboard updated!" << endl;
-
-                                // Save to CSV
-                                if (UpdateUsersCSV("../data/users.csv", loadedUsers)) {
-                                    cout << " User points saved to CSV" << endl;
-                                }
                             } else {
                                 cout << "ℹ  No users had drivers in this race" << endl;
                             }
 
-                            // Update CSV after race
-                            if (UpdateDriversCSV("../data/drivers.csv", drivers)) {
-                                cout << " Driver points updated in CSV file" << endl;
+                            // Append this race's point changes to the journal
+                            if (journal.commit()) {
+                                cout << " Driver and user points saved to journal" << endl;
                             } else {
-                                cout << " Failed to update CSV file" << endl;
+                                cout << " Failed to write points journal" << endl;
                             }
+                            CompactJournal(journal, drivers, constructors, loadedUsers, false);
 
-                            // Rebuild AVL tree
-                            cout << "Rebuilding AVL tree with updated points..." << endl;
-                            avlTree.clear();
-                            for (Driver& dr : drivers) {
-                                avlTree.insert(dr);
+                            // Re-key only the drivers who scored
+                            cout << "Updating AVL tree with new points..." << endl;
+                            for (const RaceResult& result : results) {
+                                if (result.pointsEarned != 0) {
+                                    avlTree.update((uint32_t)(result.driver - drivers.data()));
+                                }
                             }
                             cout << "AVL tree updated!" << endl;
 
@@ -510,6 +518,14 @@ int main() {
 
                             cout << "\n🏁 SIMULATING " << numRaces << " RACES..." << endl;
 
+                            // One seed reproduces the whole season; each race
+                            // draws from its own stream of it
+                            uint64_t seasonSeed = Random::randomSeed();
+                            cout << "Season seed: " << seasonSeed << endl;
+
+                            // Each race's commentary goes out in one write
+                            TextRaceSink seasonCommentary(cout, true);
+
                             string raceNames[] = {"Bahrain", "Saudi Arabia", "Australia", "Japan", "China",
                                                 "Miami", "Monaco", "Spain", "Canada", "Austria",
                                                 "Britain", "Hungary", "Belgium", "Netherlands", "Italy",
@@ -520,38 +536,24 @@ int main() {
                                 string raceName = raceNames[i % 23] + " GP";
                                 cout << "\n--- Race " << (i+1) << "/" << numRaces << ": " << raceName << " ---" << endl;
 
-                                RaceSimulator race(raceName);
+                                RaceSimulator race(raceName, seasonSeed, i);
+                                race.setEventSink(seasonCommentary);
+                                race.setRaceLog(&raceLog);
                                 for (Driver& d : drivers) {
                                     race.addDriver(&d);
                                 }
 
                                 race.runRace();
+                                SaveRaceLog(journal, raceLog);
                                 race.displayResults();
 
                                 // Track performance for each driver in this race
-                                vector<RaceResult> results = race.getResults();
+                                const vector<RaceResult>& results = race.getResults();
 
                                 // Update user points based on their drivers' performance
-                                for (User* user : loadedUsers) {
-                                    int userPointsGained = 0;
-                                    vector<Driver> userDrivers = user->getTeam().getDrivers();
-
-                                    // Check each of the user's drivers
-                                    for (const Driver& userDriver : userDrivers) {
-                                        // Find this driver in the race results
-                                        for (const RaceResult& result : results) {
-                                            if (result.driver != nullptr &&
-                                                result.driver->getName() == userDriver.getName()) {
-                                                userPointsGained += result.pointsEarned;
-                                                break;
-                                                }
-                                        }
-                                    }
-
-                                    if (userPointsGained > 0) {
-                                        user->addPoints(userPointsGained);
-                                    }
-                                }
+                                JournalRace(journal, raceName, results, drivers);
+                                ScoreRace(scoring, standings, journal, results, constructors, loadedUsers, false);
+                                journal.commit();
 
                                 cout << "\nPress Enter for next race...";
                                 cin.get();
@@ -559,32 +561,22 @@ int main() {
 
                             cout << "\n All race performance data has been recorded!" << endl;
 
-                            // Update CSV after all races
-                            if (UpdateDriversCSV("../data/drivers.csv", drivers)) {
-                                cout << " All driver points updated in CSV file!" << endl;
-                            } else {
-                                cout << " Failed to update CSV file!" << endl;
-                            }
-
-                            // Save user points to CSV
-                            if (UpdateUsersCSV("../data/users.csv", loadedUsers)) {
-                                cout << " User points saved to CSV!" << endl;
-                            }
+                            // Each race was journaled as it finished
+                            cout << " All driver and user points saved to journal!" << endl;
+                            CompactJournal(journal, drivers, constructors, loadedUsers, false);
 
                             // Update leaderboard
-                            leaderboard.clear();
-                            for (User* user : loadedUsers) {
-                                leaderboard.addUser(user);
-                            }
+                            leaderboard.invalidateRankings();
 
                             // Final standings
                             cout << "\n FINAL SEASON STANDINGS " << endl;
-                            avlTree.clear();
-                            for (Driver& dr : drivers) {
-                                avlTree.insert(dr);
-                            }
+                            // A whole season moves nearly everyone, so rebuild
+                            avlTree.rebuild();
                             avlTree.displayRankings();
 
+                            cout << "\n FINAL CONSTRUCTOR STANDINGS " << endl;
+                            standings.display();
+
                             // Show final user leaderboard
                             cout << "\n FINAL USER LEADERBOARD:" << endl;
                             leaderboard.displayTopN(10);
@@ -592,7 +584,89 @@ int main() {
                             break;
                         }
 
-                        case 4:
+                        case 4: {
+                            // Headless seasons from the current standings; nothing is saved
+                            size_t numSeasons;
+                            int numRaces;
+                            int numLaps;
+                            uint64_t seed;
+                            cout << "How many seasons to simulate? (1-1000000): ";
+                            cin >> numSeasons;
+                            cout << "Races per season? (1-23): ";
+                            cin >> numRaces;
+                            cout << "Laps per race? (0 for finishing order only, up to 80): ";
+                            cin >> numLaps;
+                            cout << "Seed (0 for random): ";
+                            cin >> seed;
+                            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+                            if (!cin || numSeasons < 1 || numSeasons > 1000000 || numRaces < 1 || numRaces > 23 ||
+                                numLaps < 0 || numLaps > 80) {
+                                cin.clear();
+                                cout << "Invalid input!" << endl;
+                                break;
+                            }
+                            if (seed == 0) {
+                                seed = Random::randomSeed();
+                            }
+
+                            auto start = chrono::steady_clock::now();
+                            MonteCarloSeason projection(drivers, loadedUsers, scoring);
+                            projection.run(numSeasons, numRaces, seed, numLaps);
+                            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+                            projection.display(10);
+                            cout << "\nSimulated " << numSeasons << " seasons in " << seconds
+                                 << "s (seed " << seed << ")" << endl;
+                            break;
+                        }
+
+                        case 5: {
+                            // Rebuilt from the log on a copy of the drivers, so
+                            // an audit never changes the standings
+                            size_t raceCount = raceLog.getRaceCount();
+                            if (raceCount == 0) {
+                                cout << "No races logged yet!" << endl;
+                                break;
+                            }
+
+                            size_t raceNumber;
+                            cout << "Race to replay? (1-" << raceCount << ", 1 = oldest): ";
+                            cin >> raceNumber;
+                            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+                            RaceRecord record;
+                            if (!cin || raceNumber < 1 || raceNumber > raceCount ||
+                                !raceLog.read(raceNumber - 1, record)) {
+                                cin.clear();
+                                cout << "Invalid race number!" << endl;
+                                break;
+                            }
+
+                            vector<Driver> auditDrivers = drivers;
+                            RaceSimulator race(record.raceName);
+                            bool entrantsFound = true;
+                            for (int index : record.entrants) {
+                                if (index >= (int)auditDrivers.size()) {
+                                    entrantsFound = false;
+                                    break;
+                                }
+                                race.addDriver(&auditDrivers[index]);
+                            }
+
+                            if (!entrantsFound || !race.replayRace(record)) {
+                                cout << "Logged race doesn't match the current drivers!" << endl;
+                                break;
+                            }
+                            race.displayResults();
+                            cout << "Seed " << record.seed << ", stream " << record.stream
+                                 << ", race " << record.raceNumber + 1 << " of that simulator"
+                                 << (record.lapCount > 0 ? ", " + to_string(record.lapCount) + " laps" : "")
+                                 << endl;
+                            break;
+                        }
+
+                        case 6:
                             cout << "Returning to main menu..." << endl;
                             break;
 
@@ -600,11 +674,11 @@ int main() {
                             cout << "Invalid choice!" << endl;
                     }
 
-                    if (raceChoice != 4 && raceChoice >= 1 && raceChoice <= 3) {
+                    if (raceChoice >= 1 && raceChoice <= 5) {
                         cout << "\nPress Enter to continue...";
                         cin.get();
                     }
-                } while (raceChoice != 4);
+                } while (raceChoice != 6);
                 break;
             }
             case 6:
@@ -618,7 +692,12 @@ int main() {
                 cout << "\nSession Summary:" << endl;
                 cout << "Teams Created: " << leaderboard.getTotalUsers() << endl;
 
-                UpdateUsersCSV("../data/users.csv", loadedUsers);
+                // Fold the journal into the CSVs before the users are freed
+                CompactJournal(journal, drivers, constructors, loadedUsers, true);
+                ReportWriterFailures(journal, raceLog);
+
+                // Saved rankings let the next start skip sorting
+                leaderboard.exportToFile("../data/leaderboard.txt");
 
                 // Clean up users
                 for (User* user : loadedUsers) {
@@ -660,7 +739,8 @@ void displayAVLMenu(AVLTree& avlTree) {
         cout << "1. View All Driver Rankings" << endl;
         cout << "2. View Top 10 Drivers" << endl;
         cout << "3. Search for Specific Driver" << endl;
-        cout << "4. Back to Main Menu" << endl;
+        cout << "4. Drivers in Points Range" << endl;
+        cout << "5. Back to Main Menu" << endl;
         cout << "Choose an option: ";
         cin >> choice;
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -673,15 +753,15 @@ void displayAVLMenu(AVLTree& avlTree) {
             }
 
             case 2: {
-                vector<Driver> top10 = avlTree.getTopNDrivers(10);
                 cout << "\n=== TOP 10 DRIVERS ===" << endl;
                 cout << "Rank | Code | Name                | Points | Price" << endl;
                 cout << "---------------------------------------------------" << endl;
-                for (size_t i = 0; i < top10.size(); i++) {
-                    cout << (i + 1) << ".   " << top10[i].getCode() << "     "
-                         << setw(20) << left << top10[i].getName()
-                         << setw(6) << right << top10[i].getPoints() << "     "
-                         << top10[i].getPrice() << "M" << endl;
+                int rank = 1;
+                for (AVLTree::Iterator it = avlTree.begin(); it != avlTree.end() && rank <= 10; ++it, rank++) {
+                    cout << rank << ".   " << it->getCode() << "     "
+                         << setw(20) << left << it->getName()
+                         << setw(6) << right << it->getPoints() << "     "
+                         << it->getPrice() << "M" << endl;
                 }
                 break;
             }
@@ -691,7 +771,7 @@ void displayAVLMenu(AVLTree& avlTree) {
                 cout << "Enter driver code: ";
                 getline(cin, code);
 
-                Driver* found = avlTree.search(code);
+                const Driver* found = avlTree.search(code);
                 if (found != nullptr) {
                     cout << "\n=== DRIVER FOUND ===" << endl;
                     cout << "Code: " << found->getCode() << endl;
@@ -699,13 +779,48 @@ void displayAVLMenu(AVLTree& avlTree) {
                     cout << "Team: " << found->getTeam() << endl;
                     cout << "Points: " << found->getPoints() << endl;
                     cout << "Price: " << found->getPrice() << "M" << endl;
+                    cout << "Rank: " << avlTree.getRank(found->getCode())
+                         << " of " << avlTree.size() << endl;
                 } else {
                     cout << "Driver not found!" << endl;
                 }
                 break;
             }
 
-            case 4:
+            case 4: {
+                int minPoints = 0, maxPoints = 0;
+                cout << "Minimum points: ";
+                cin >> minPoints;
+                cout << "Maximum points: ";
+                cin >> maxPoints;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+                if (!cin) {
+                    cin.clear();
+                    cout << "Invalid input!" << endl;
+                    break;
+                }
+
+                AVLTree::DriverRange matches = avlTree.range(minPoints, maxPoints);
+                if (matches.empty()) {
+                    cout << "No drivers with " << minPoints << "-" << maxPoints << " points." << endl;
+                    break;
+                }
+
+                cout << "\n=== DRIVERS WITH " << minPoints << "-" << maxPoints << " POINTS ===" << endl;
+                cout << "Rank | Code | Name                | Points | Price" << endl;
+                cout << "---------------------------------------------------" << endl;
+                int rank = avlTree.getRank(matches.first->getCode());
+                for (const Driver& d : matches) {
+                    cout << rank++ << ".   " << d.getCode() << "     "
+                         << setw(20) << left << d.getName()
+                         << setw(6) << right << d.getPoints() << "     "
+                         << d.getPrice() << "M" << endl;
+                }
+                break;
+            }
+
+            case 5:
                 cout << "Returning to main menu..." << endl;
                 break;
 
@@ -713,11 +828,11 @@ void displayAVLMenu(AVLTree& avlTree) {
                 cout << "Invalid choice! Try again." << endl;
         }
 
-        if (choice != 4) {
+        if (choice != 5) {
             cout << "\nPress Enter to continue...";
             cin.get();
         }
-    } while (choice != 4);
+    } while (choice != 5);
 }
 
 // SORTING MENU
@@ -877,119 +992,204 @@ void displayLeaderboardMenu(Leaderboard& leaderboard, vector<User*>& loadedUsers
 
 vector<Driver> LoadDrivers(string filename) {
     vector<Driver> drivers;
-    ifstream file(filename);
-    string line;
-    getline(file, line);
-
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string code, name, team;
-        int points, avgFinishes, wins, podiums;
+    MappedFile file;
+    if (!file.open(filename)) {
+        return drivers;
+    }
+
+    CsvReader reader(file.begin(), file.end());
+    CsvRow row;
+    reader.nextRow(row);  // Skip header
+
+    while (reader.nextRow(row)) {
+        if (row.isEmpty()) continue;
+
+        int points, avgFinishes = 0, wins = 0, podiums = 0;
         float price;
 
-        getline(ss, code, ',');
-        getline(ss, name, ',');
-        getline(ss, team, ',');
-        ss >> points; ss.ignore();
-        ss >> price; ss.ignore();
-        ss >> avgFinishes; ss.ignore();
-        ss >> wins; ss.ignore();
-        ss >> podiums;
+        if (row.fieldCount < 5) {
+            reader.addError(row.line, "expected code,name,team,points,price[,avgFinishes,wins,podiums]");
+            continue;
+        }
+        if (!CsvReader::parseInt(row.fields[3], points) || !CsvReader::parseFloat(row.fields[4], price)) {
+            reader.addError(row.line, "invalid points or price for driver '" + string(row.fields[0]) + "'");
+            continue;
+        }
+
+        // Season stats are optional
+        if (row.fieldCount > 5) CsvReader::parseInt(row.fields[5], avgFinishes);
+        if (row.fieldCount > 6) CsvReader::parseInt(row.fields[6], wins);
+        if (row.fieldCount > 7) CsvReader::parseInt(row.fields[7], podiums);
 
-        drivers.push_back(Driver(code, name, team, points, price, avgFinishes, wins, podiums));
+        drivers.push_back(Driver(string(row.fields[0]), string(row.fields[1]), string(row.fields[2]),
+                                 points, price, avgFinishes, wins, podiums));
     }
+
+    CsvReader::reportErrors(filename, reader.getErrors());
     return drivers;
 }
 
 vector<Constructors> LoadConstructors(string filename) {
     vector<Constructors> constructors;
-    ifstream file(filename);
-    string line;
-    getline(file,line);
+    MappedFile file;
+    if (!file.open(filename)) {
+        return constructors;
+    }
 
-    while (getline(file,line)) {
-        stringstream ss(line);
-        string code, teamname;
-        float price;
+    CsvReader reader(file.begin(), file.end());
+    CsvRow row;
+    reader.nextRow(row);  // Skip header
 
-        getline(ss,code,',');
-        getline(ss,teamname, ',');
-        ss >> price; ss.ignore();
+    while (reader.nextRow(row)) {
+        if (row.isEmpty()) continue;
 
-        constructors.push_back(Constructors(code,teamname,price));
+        // The points column is optional for files from before constructors scored
+        float price;
+        int points = 0;
+        if (row.fieldCount < 3 || !CsvReader::parseFloat(row.fields[2], price) ||
+            (row.fieldCount > 3 && !CsvReader::parseInt(row.fields[3], points))) {
+            reader.addError(row.line, "expected code,teamName,price,points");
+            continue;
+        }
+
+        Constructors constructor(string(row.fields[0]), string(row.fields[1]), price);
+        constructor.addpoints(points);
+        constructors.push_back(constructor);
     }
+
+    CsvReader::reportErrors(filename, reader.getErrors());
     return constructors;
 }
 
-// NEW: Load users from CSV file
-vector<User*> LoadUsersFromCSV(string filename, const vector<Driver>& drivers, const vector<Constructors>& constructors) {
-    vector<User*> users;
-    ifstream file(filename);
-
-    if (!file.is_open()) {
-        cout << "Warning: Could not open " << filename << endl;
-        return users;
-    }
+// Name lookups shared read-only by every users.csv chunk
+struct UserLookups {
+    unordered_map<string_view, const Driver*> driversByName;
+    unordered_map<string_view, const Constructors*> constructorsByName;
+    Constructors unknownConstructor;  // Used if constructor not found
 
-    string line;
-    getline(file, line);  // Skip header
+    UserLookups() : unknownConstructor("UNK", "Unknown", 10.0) {}
+};
 
-    while (getline(file, line)) {
-        if (line.empty()) continue;
+// Parse users from one line-aligned slice of users.csv. Line numbers are
+// relative to the slice; the caller shifts them once all slices are done.
+void ParseUserRows(CsvReader& reader, const UserLookups& lookups, vector<User*>& users) {
+    CsvRow row;
 
-        stringstream ss(line);
-        string username, constructorName, driver1Name, driver2Name;
-        float budget;
-        int points;
+    while (reader.nextRow(row)) {
+        if (row.isEmpty()) continue;
 
-        getline(ss, username, ',');
-        ss >> budget; ss.ignore();
-        getline(ss, constructorName, ',');
-        getline(ss, driver1Name, ',');
-        getline(ss, driver2Name, ',');
-        ss >> points;
-
-        // Find constructor
-        Constructors* foundConstructor = nullptr;
-        for (const Constructors& c : constructors) {
-            if (c.getTeamName() == constructorName) {
-                foundConstructor = new Constructors(c);
-                break;
-            }
+        // username,budget,constructor,driver_1..driver_n,points
+        if (row.fieldCount < 5 || row.fieldCount > CSV_MAX_FIELDS) {
+            reader.addError(row.line, "expected username,budget,constructor,driver_1,driver_2,points");
+            continue;
         }
 
-        if (foundConstructor == nullptr) {
-            // Use default constructor if not found
-            foundConstructor = new Constructors("UNK", "Unknown", 10.0);
+        float budget;
+        int points;
+        if (!CsvReader::parseFloat(row.fields[1], budget) ||
+            !CsvReader::parseInt(row.fields[row.fieldCount - 1], points)) {
+            reader.addError(row.line, "invalid budget or points for user '" + string(row.fields[0]) + "'");
+            continue;
         }
 
-        // Create team with constructor
-        Team* userTeam = new Team(budget, *foundConstructor);
-
-        // Find and add drivers
-        for (const Driver& d : drivers) {
-            if (d.getName() == driver1Name || d.getName() == driver2Name) {
-                userTeam->addDriver(d);
+        // Resolve constructor
+        auto constructorIt = lookups.constructorsByName.find(row.fields[2]);
+        Team userTeam(budget, constructorIt != lookups.constructorsByName.end()
+                                  ? *constructorIt->second
+                                  : lookups.unknownConstructor);
+
+        // Resolve drivers
+        for (int i = 3; i < row.fieldCount - 1; i++) {
+            auto driverIt = lookups.driversByName.find(row.fields[i]);
+            if (driverIt != lookups.driversByName.end()) {
+                userTeam.addDriver(*driverIt->second);
             }
         }
 
         // Create user
-        User* user = new User(username, budget, *userTeam);
+        User* user = new User(string(row.fields[0]), budget, move(userTeam));
         user->setPoints(points);  // Set loaded points
 
         users.push_back(user);
+    }
+}
+
+// NEW: Load users from CSV file
+vector<User*> LoadUsersFromCSV(string filename, const vector<Driver>& drivers, const vector<Constructors>& constructors) {
+    vector<User*> users;
+    MappedFile file;
 
-        delete foundConstructor;
-        delete userTeam;
+    if (!file.open(filename)) {
+        cout << "Warning: Could not open " << filename << endl;
+        return users;
     }
 
-    file.close();
+    // Build name lookups once so every row resolves its team in O(1).
+    // Keys view the names owned by the caller's vectors.
+    UserLookups lookups;
+    lookups.driversByName.reserve(drivers.size());
+    for (const Driver& d : drivers) {
+        lookups.driversByName.emplace(d.getName(), &d);
+    }
+
+    lookups.constructorsByName.reserve(constructors.size());
+    for (const Constructors& c : constructors) {
+        lookups.constructorsByName.emplace(c.getTeamName(), &c);
+    }
+
+    CsvReader header(file.begin(), file.end());
+    CsvRow row;
+    header.nextRow(row);  // Skip header
+    const char* body = header.getPosition();
+    size_t bodyFirstLine = header.getLineNumber();
+
+    // Small files aren't worth waking the pool for
+    const size_t PARALLEL_MIN_BYTES = 1 << 20;
+    ThreadPool& pool = ThreadPool::shared();
+    size_t chunkCount = (size_t)(file.end() - body) < PARALLEL_MIN_BYTES ? 1 : pool.concurrency() * 4;
+    vector<const char*> bounds = CsvReader::splitAtLines(body, file.end(), chunkCount);
+
+    struct UserChunk {
+        vector<User*> users;
+        vector<CsvError> errors;
+        size_t lines = 0;
+    };
+    vector<UserChunk> chunks(bounds.size() - 1);
+
+    // Every chunk starts on a fresh line, so chunks parse independently
+    pool.parallelFor(chunks.size(), [&](size_t c) {
+        CsvReader reader(bounds[c], bounds[c + 1]);
+        ParseUserRows(reader, lookups, chunks[c].users);
+        chunks[c].errors = reader.getErrors();
+        chunks[c].lines = reader.getLineNumber() - 1;
+    });
+
+    // Stitch chunks back together in file order
+    size_t total = 0;
+    for (const UserChunk& chunk : chunks) {
+        total += chunk.users.size();
+    }
+    users.reserve(total);
+
+    vector<CsvError> errors;
+    size_t lineOffset = bodyFirstLine - 1;
+    for (UserChunk& chunk : chunks) {
+        users.insert(users.end(), chunk.users.begin(), chunk.users.end());
+        for (CsvError& error : chunk.errors) {
+            error.line += lineOffset;
+            errors.push_back(move(error));
+        }
+        lineOffset += chunk.lines;
+    }
+
+    CsvReader::reportErrors(filename, errors);
     return users;
 }
 
 //Update users CSV file
 bool UpdateUsersCSV(string filename, const vector<User*>& users) {
-    ofstream file(filename);
+    string tempName = filename + ".tmp";
+    ofstream file(tempName);
 
     if (!file.is_open()) {
         return false;
@@ -1018,49 +1218,126 @@ bool UpdateUsersCSV(string filename, const vector<User*>& users) {
     }
 
     file.close();
-    return true;
+    return !file.fail() && ReplaceFile(tempName, filename);
 }
 
-void updateUserPointsFromRace(vector<User*>& users, const vector<RaceResult>& results, Leaderboard& leaderboard) {
-    cout << "\nUpdating user points based on driver performance..." << endl;
-    int usersUpdated = 0;
-
-    for (User* user : users) {
-        int userPointsGained = 0;
-        vector<Driver> userDrivers = user->getTeam().getDrivers();
-
-        // Check each of the user's drivers
-        for (const Driver& userDriver : userDrivers) {
-            // Find this driver in the race results
-            for (const RaceResult& result : results) {
-                if (result.driver != nullptr &&
-                    result.driver->getName() == userDriver.getName()) {
-                    userPointsGained += result.pointsEarned;
-                    break;
-                    }
-            }
+// Swap a fully written temp file into place so readers never see half a file
+bool ReplaceFile(const string& tempName, const string& filename) {
+    error_code ec;
+    filesystem::rename(tempName, filename, ec);
+    return !ec;
+}
+
+// Refresh the binary snapshot after the CSVs change so the next start can skip parsing
+void SaveSnapshot(const vector<Driver>& drivers, const vector<Constructors>& constructors, const vector<User*>& users) {
+    if (!Snapshot::write("../data/snapshot.bin", drivers, constructors, users)) {
+        cout << " Failed to write snapshot!" << endl;
+    }
+}
+
+// Record a race header plus every driver that scored; users are recorded by the caller
+void JournalRace(PointsJournal& journal, const string& raceName, const vector<RaceResult>& results, const vector<Driver>& drivers) {
+    journal.beginRace(raceName);
+
+    for (const RaceResult& result : results) {
+        if (result.driver == nullptr || result.pointsEarned == 0) continue;
+
+        size_t index = result.driver - drivers.data();
+        if (index < drivers.size()) {
+            journal.recordDriver(index, *result.driver, result.pointsEarned);
         }
+    }
+}
 
-        if (userPointsGained > 0) {
-            user->addPoints(userPointsGained);
-            cout << "  " << user->getUsername() << ": +" << userPointsGained
-                 << " points (Total: " << user->getPoints() << ")" << endl;
-            usersUpdated++;
+// Appends races logged since the last save, a few bytes each, on the
+// journal's writer thread so races never wait on disk
+void SaveRaceLog(PointsJournal& journal, RaceLog& raceLog) {
+    journal.enqueueWrite(raceLog.takeUnsavedWrite("../data/races.log"));
+}
+
+// Background saves can't print without garbling the menus, so their
+// failures are shown here, before the next prompt
+void ReportWriterFailures(PointsJournal& journal, RaceLog& raceLog) {
+    if (journal.takeCompactionFailure()) {
+        cout << " Journal compaction failed; records kept for next start" << endl;
+    }
+    if (raceLog.takeSaveFailure()) {
+        cout << " Failed to write race log; it will be rewritten on next save" << endl;
+    }
+}
+
+// Fold the journal into the CSVs and snapshot once it has grown as large as
+// they are (or always, with wait). The journal's writer thread does the
+// rewrite from a private copy of the state, so races never wait on it.
+void CompactJournal(PointsJournal& journal, const vector<Driver>& drivers, const vector<Constructors>& constructors,
+                    const vector<User*>& users, bool wait) {
+    if (!wait && !journal.needsCompaction(drivers.size() + constructors.size() + users.size())) {
+        return;
+    }
+
+    struct BaseState {
+        vector<Driver> drivers;
+        vector<Constructors> constructors;
+        vector<User> users;
+    };
+
+    shared_ptr<BaseState> state = make_shared<BaseState>();
+    state->drivers = drivers;
+    state->constructors = constructors;
+    state->users.reserve(users.size());
+    for (const User* user : users) {
+        state->users.push_back(*user);
+    }
+
+    journal.compact([state]() {
+        vector<User*> userPtrs;
+        userPtrs.reserve(state->users.size());
+        for (User& user : state->users) {
+            userPtrs.push_back(&user);
         }
+
+        return UpdateUsersCSV("../data/users.csv", userPtrs) &&
+               UpdateDriversCSV("../data/drivers.csv", state->drivers) &&
+               UpdateConstructorsCSV("../data/constructors.csv", state->constructors) &&
+               Snapshot::write("../data/snapshot.bin", state->drivers, state->constructors, userPtrs);
+    });
+
+    if (wait) {
+        journal.waitForWrites();
     }
+}
+
+// Score a race through the ownership index and journal every user who gained points
+int ScoreRace(ScoringIndex& scoring, ConstructorStandings& standings, PointsJournal& journal,
+              const vector<RaceResult>& results, const vector<Constructors>& constructors,
+              vector<User*>& users, bool verbose) {
+    const vector<UserScore>& scores = scoring.scoreRace(results, users);
 
-    if (usersUpdated > 0) {
-        cout << " Updated points for " << usersUpdated << " users!" << endl;
+    // Constructors earn what their drivers scored, worked out in the same pass
+    const vector<int>& constructorPoints = scoring.getConstructorPoints();
+    standings.applyRace(constructorPoints);
 
-        // Update leaderboard
-        leaderboard.clear();
-        for (User* user : users) {
-            leaderboard.addUser(user);
+    for (size_t c = 0; c < constructorPoints.size(); c++) {
+        if (constructorPoints[c] == 0) continue;
+
+        journal.recordConstructor(c, constructors[c], constructorPoints[c]);
+        if (verbose) {
+            cout << "  " << constructors[c].getTeamName() << ": +" << constructorPoints[c]
+                 << " constructor points (Total: " << constructors[c].getPoints() << ")" << endl;
+        }
+    }
+
+    for (const UserScore& score : scores) {
+        const User* user = users[score.userIndex];
+        journal.recordUser(score.userIndex, *user, score.pointsGained);
+
+        if (verbose) {
+            cout << "  " << user->getUsername() << ": +" << score.pointsGained
+                 << " points (Total: " << user->getPoints() << ")" << endl;
         }
-        cout << " Leaderboard updated!" << endl;
-    } else {
-        cout << "ℹ  No users had drivers in this race" << endl;
     }
+
+    return (int)scores.size();
 }
 
 
@@ -1101,22 +1378,10 @@ Constructors SelectConstructor(const vector<Constructors> &constructors) {
     }
 }
 
-bool StoreUserTeam(string filename, User user) {
-    ofstream file(filename, ios::app);
-
-    file << user.getUsername() << "," << user.getBudget() << "," << user.getTeam().getConstructor().getTeamName() << ",";
-    vector<Driver> drivers = user.getTeam().getDrivers();
-    for (Driver d : drivers) {
-        file << d.getName() << ",";
-    }
-    file << user.getPoints();
-    file << "\n";
-    return true;
-}
-
 // Function to update drivers CSV file with current points
 bool UpdateDriversCSV(string filename, const vector<Driver>& drivers) {
-    ofstream file(filename);
+    string tempName = filename + ".tmp";
+    ofstream file(tempName);
 
     if (!file.is_open()) {
         return false;
@@ -1136,5 +1401,30 @@ bool UpdateDriversCSV(string filename, const vector<Driver>& drivers) {
     }
 
     file.close();
-    return true;
+    return !file.fail() && ReplaceFile(tempName, filename);
+}
+
+// Function to update constructors CSV file with current points
+bool UpdateConstructorsCSV(string filename, const vector<Constructors>& constructors) {
+    string tempName = filename + ".tmp";
+    ofstream file(tempName);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Write header
+    file << "code,teamName,price,points\n";
+
+    // Prices keep one decimal, as in the original file
+    file << fixed << setprecision(1);
+    for (const Constructors& c : constructors) {
+        file << c.getCode() << ","
+             << c.getTeamName() << ","
+             << c.getPrice() << ","
+             << c.getPoints() << "\n";
+    }
+
+    file.close();
+    return !file.fail() && ReplaceFile(tempName, filename);
 }
\ No newline at end of file
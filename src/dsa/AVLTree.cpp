@@ -3,41 +3,58 @@
 //
 
 #include "AVLTree.h"
+#include <algorithm>
 #include <iomanip>
+#include <numeric>
 
-// ============ CONSTRUCTOR & DESTRUCTOR ============
+// ============ CONSTRUCTOR ============
 
-AVLTree::AVLTree() : root(nullptr) {}
+AVLTree::AVLTree(const vector<Driver>& drivers) : drivers(drivers), root(AVL_NIL), freeHead(AVL_NIL) {}
 
-AVLTree::~AVLTree() {
-    destroyTree(root);
+// ============ NODE POOL ============
+
+uint32_t AVLTree::allocateNode(uint32_t id) {
+    uint32_t node = freeHead;
+    if (node != AVL_NIL) {
+        freeHead = nodes[node].left;
+        nodes[node] = AVLNode(drivers[id].getPoints(), id);
+    } else {
+        node = (uint32_t)nodes.size();
+        nodes.push_back(AVLNode(drivers[id].getPoints(), id));
+    }
+    return node;
 }
 
-void AVLTree::destroyTree(AVLNode* node) {
-    if (node == nullptr) return;
-    destroyTree(node->left);
-    destroyTree(node->right);
-    delete node;
+void AVLTree::freeNode(uint32_t node) {
+    nodes[node].left = freeHead;
+    freeHead = node;
 }
 
 // ============ HEIGHT & BALANCE FUNCTIONS ============
 
-int AVLTree::getHeight(AVLNode* node) {
-    if (node == nullptr) return 0;
-    return node->height;
+int AVLTree::getHeight(uint32_t node) const {
+    if (node == AVL_NIL) return 0;
+    return nodes[node].height;
+}
+
+int AVLTree::getSize(uint32_t node) const {
+    if (node == AVL_NIL) return 0;
+    return nodes[node].size;
 }
 
-int AVLTree::getBalanceFactor(AVLNode* node) {
-    if (node == nullptr) return 0;
-    return getHeight(node->left) - getHeight(node->right);
+int AVLTree::getBalanceFactor(uint32_t node) const {
+    if (node == AVL_NIL) return 0;
+    return getHeight(nodes[node].left) - getHeight(nodes[node].right);
 }
 
-AVLNode* AVLTree::updateHeight(AVLNode* node) {
-    if (node == nullptr) return nullptr;
+uint32_t AVLTree::updateNode(uint32_t node) {
+    if (node == AVL_NIL) return AVL_NIL;
 
-    int leftHeight = getHeight(node->left);
-    int rightHeight = getHeight(node->right);
-    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    AVLNode& n = nodes[node];
+    int leftHeight = getHeight(n.left);
+    int rightHeight = getHeight(n.right);
+    n.height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    n.size = 1 + getSize(n.left) + getSize(n.right);
 
     return node;
 }
@@ -50,17 +67,17 @@ AVLNode* AVLTree::updateHeight(AVLNode* node) {
 //     x   C    ----- >     A   y
 //    / \                      / \
 //   A   B                    B   C
-AVLNode* AVLTree::rotateRight(AVLNode* y) {
-    AVLNode* x = y->left;
-    AVLNode* B = x->right;
+uint32_t AVLTree::rotateRight(uint32_t y) {
+    uint32_t x = nodes[y].left;
+    uint32_t B = nodes[x].right;
 
     // Perform rotation
-    x->right = y;
-    y->left = B;
+    nodes[x].right = y;
+    nodes[y].left = B;
 
-    // Update heights
-    updateHeight(y);
-    updateHeight(x);
+    // Update heights and sizes, lower node first
+    updateNode(y);
+    updateNode(x);
 
     return x;
 }
@@ -71,114 +88,226 @@ AVLNode* AVLTree::rotateRight(AVLNode* y) {
 //   A   y      ------>     x   C
 //      / \                / \
 //     B   C              A   B
-AVLNode* AVLTree::rotateLeft(AVLNode* x) {
-    AVLNode* y = x->right;
-    AVLNode* B = y->left;
+uint32_t AVLTree::rotateLeft(uint32_t x) {
+    uint32_t y = nodes[x].right;
+    uint32_t B = nodes[y].left;
 
     // Perform rotation
-    y->left = x;
-    x->right = B;
+    nodes[y].left = x;
+    nodes[x].right = B;
 
-    // Update heights
-    updateHeight(x);
-    updateHeight(y);
+    // Update heights and sizes, lower node first
+    updateNode(x);
+    updateNode(y);
 
     return y;
 }
 
+// ============ BALANCING ============
+
+// Tree order is ranking order (see ranksAhead), so higher points go to the
+// left. Keys come from the nodes; driver codes are read only on ties.
+bool AVLTree::comesBefore(uint32_t a, uint32_t b) const {
+    if (nodes[a].points != nodes[b].points) return nodes[a].points > nodes[b].points;
+    return driverOf(a).getCode() < driverOf(b).getCode();
+}
+
+// Restores the AVL property at node after one of its subtrees changed
+// height by at most one, as after a single insert or delete below it
+uint32_t AVLTree::rebalance(uint32_t node) {
+    updateNode(node);
+    int balance = getBalanceFactor(node);
+
+    if (balance > 1) {
+        // Left-Right Case (LR) first becomes Left-Left
+        if (getBalanceFactor(nodes[node].left) < 0) {
+            nodes[node].left = rotateLeft(nodes[node].left);
+        }
+        return rotateRight(node);
+    }
+
+    if (balance < -1) {
+        // Right-Left Case (RL) first becomes Right-Right
+        if (getBalanceFactor(nodes[node].right) > 0) {
+            nodes[node].right = rotateRight(nodes[node].right);
+        }
+        return rotateLeft(node);
+    }
+
+    return node;
+}
+
 // ============ INSERT OPERATION ============
 
-void AVLTree::insert(const Driver& driver) {
-    root = insertNode(root, driver);
+void AVLTree::insert(uint32_t id) {
+    if (id >= drivers.size() || update(id)) return;
+
+    if (nodeOfDriver.size() < drivers.size()) {
+        nodeOfDriver.resize(drivers.size(), AVL_NIL);
+    }
+    uint32_t created = allocateNode(id);
+    nodeOfDriver[id] = created;
+    nodeByCode[drivers[id].getCode()] = created;
+    root = linkNode(root, created);
 }
 
-AVLNode* AVLTree::insertNode(AVLNode* node, const Driver& driver) {
+uint32_t AVLTree::linkNode(uint32_t node, uint32_t fresh) {
     // Perform normal BST insertion
-    if (node == nullptr) {
-        return new AVLNode(driver);
+    if (node == AVL_NIL) {
+        return fresh;
     }
 
-    // Insert based on points (higher points go to left for descending order)
-    // For same points, use code as tiebreaker
-    if (driver.getPoints() > node->driver.getPoints() ||
-        (driver.getPoints() == node->driver.getPoints() &&
-         driver.getCode() < node->driver.getCode())) {
-        node->left = insertNode(node->left, driver);
+    if (comesBefore(fresh, node)) {
+        nodes[node].left = linkNode(nodes[node].left, fresh);
     } else {
-        node->right = insertNode(node->right, driver);
+        nodes[node].right = linkNode(nodes[node].right, fresh);
     }
 
-    // 2. Update height of current node
-    updateHeight(node);
+    return rebalance(node);
+}
 
-    // 3. Get balance factor
-    int balance = getBalanceFactor(node);
+// ============ DELETE & UPDATE OPERATIONS ============
 
-    // 4. Balance the tree if needed
+bool AVLTree::remove(uint32_t id) {
+    if (id >= nodeOfDriver.size() || nodeOfDriver[id] == AVL_NIL) return false;
 
-    // Left-Left Case (LL)
-    if (balance > 1 && (driver.getPoints() > node->left->driver.getPoints() ||
-        (driver.getPoints() == node->left->driver.getPoints() &&
-         driver.getCode() < node->left->driver.getCode()))) {
-        return rotateRight(node);
-    }
+    uint32_t node = nodeOfDriver[id];
+    root = detachNode(root, node);
+    nodeOfDriver[id] = AVL_NIL;
+    nodeByCode.erase(drivers[id].getCode());
+    freeNode(node);
+    return true;
+}
 
-    // Right-Right Case (RR)
-    if (balance < -1 && (driver.getPoints() < node->right->driver.getPoints() ||
-        (driver.getPoints() == node->right->driver.getPoints() &&
-         driver.getCode() > node->right->driver.getCode()))) {
-        return rotateLeft(node);
+bool AVLTree::update(uint32_t id) {
+    if (id >= nodeOfDriver.size() || nodeOfDriver[id] == AVL_NIL) return false;
+
+    uint32_t node = nodeOfDriver[id];
+    int points = drivers[id].getPoints();
+    if (nodes[node].points == points) return true;  // Same key, same place
+
+    // Move the node itself, so both indexes stay valid. The search for it
+    // follows the old key, so change the key only once detached.
+    root = detachNode(root, node);
+    nodes[node].points = points;
+    nodes[node].left = AVL_NIL;
+    nodes[node].right = AVL_NIL;
+    updateNode(node);
+    root = linkNode(root, node);
+    return true;
+}
+
+// Unlinks target from the subtree and rebalances the path to it. Nodes are
+// relinked rather than having driver ids copied between them, so every
+// node keeps its driver.
+uint32_t AVLTree::detachNode(uint32_t node, uint32_t target) {
+    if (node == AVL_NIL) return AVL_NIL;
+
+    if (node == target) {
+        if (nodes[node].left == AVL_NIL) return nodes[node].right;
+        if (nodes[node].right == AVL_NIL) return nodes[node].left;
+
+        // Two children: the in-order successor takes target's place
+        uint32_t successor = AVL_NIL;
+        uint32_t right = detachMin(nodes[node].right, successor);
+        nodes[successor].left = nodes[node].left;
+        nodes[successor].right = right;
+        return rebalance(successor);
     }
 
-    // Left-Right Case (LR)
-    if (balance > 1 && (driver.getPoints() < node->left->driver.getPoints() ||
-        (driver.getPoints() == node->left->driver.getPoints() &&
-         driver.getCode() > node->left->driver.getCode()))) {
-        node->left = rotateLeft(node->left);
-        return rotateRight(node);
+    if (comesBefore(target, node)) {
+        nodes[node].left = detachNode(nodes[node].left, target);
+    } else {
+        nodes[node].right = detachNode(nodes[node].right, target);
     }
 
-    // Right-Left Case (RL)
-    if (balance < -1 && (driver.getPoints() > node->right->driver.getPoints() ||
-        (driver.getPoints() == node->right->driver.getPoints() &&
-         driver.getCode() < node->right->driver.getCode()))) {
-        node->right = rotateRight(node->right);
-        return rotateLeft(node);
+    return rebalance(node);
+}
+
+uint32_t AVLTree::detachMin(uint32_t node, uint32_t& minNode) {
+    if (nodes[node].left == AVL_NIL) {
+        minNode = node;
+        return nodes[node].right;
     }
 
-    return node;
+    nodes[node].left = detachMin(nodes[node].left, minNode);
+    return rebalance(node);
 }
 
-// ============ SEARCH OPERATION ============
+// ============ BULK BUILD ============
 
-Driver* AVLTree::search(const string& code) {
-    AVLNode* result = searchNode(root, code);
-    if (result == nullptr) return nullptr;
-    return &(result->driver);
+// More points first, and for the same points the code breaks the tie
+bool AVLTree::ranksAhead(const Driver& a, const Driver& b) {
+    return a.getPoints() > b.getPoints() ||
+           (a.getPoints() == b.getPoints() && a.getCode() < b.getCode());
 }
 
-AVLNode* AVLTree::searchNode(AVLNode* node, const string& code) {
-    if (node == nullptr) return nullptr;
+void AVLTree::buildFromSorted(const vector<uint32_t>& sortedIds) {
+    clear();
+
+    // Pool slot i holds the i-th driver, so in-order position and index match
+    bool ordered = true;
+    nodes.reserve(sortedIds.size());
+    nodeOfDriver.assign(drivers.size(), AVL_NIL);
+    nodeByCode.reserve(sortedIds.size());
+    for (size_t i = 0; i < sortedIds.size() && ordered; i++) {
+        uint32_t id = sortedIds[i];
+        ordered = id < drivers.size() && nodeOfDriver[id] == AVL_NIL &&
+                  (i == 0 || ranksAhead(drivers[sortedIds[i - 1]], drivers[id])) &&
+                  nodeByCode.emplace(drivers[id].getCode(), (uint32_t)i).second;
+        if (ordered) {
+            nodes.push_back(AVLNode(drivers[id].getPoints(), id));
+            nodeOfDriver[id] = (uint32_t)i;
+        }
+    }
 
-    if (node->driver.getCode() == code) {
-        return node;
+    if (!ordered) {
+        clear();
+        for (uint32_t id : sortedIds) {
+            insert(id);
+        }
+        return;
     }
 
-    // Search both subtrees since we're not organizing by code
-    AVLNode* leftResult = searchNode(node->left, code);
-    if (leftResult != nullptr) return leftResult;
+    root = buildRange(0, (uint32_t)nodes.size());
+}
+
+void AVLTree::rebuild() {
+    vector<uint32_t> ids(drivers.size());
+    iota(ids.begin(), ids.end(), 0u);
+    sort(ids.begin(), ids.end(), [this](uint32_t a, uint32_t b) {
+        return ranksAhead(drivers[a], drivers[b]);
+    });
+    buildFromSorted(ids);
+}
+
+// Middle element as the root of each half: sibling subtrees differ in size
+// by at most one, so the result is balanced without any rotations
+uint32_t AVLTree::buildRange(uint32_t first, uint32_t last) {
+    if (first >= last) return AVL_NIL;
+
+    uint32_t mid = first + (last - first) / 2;
+    nodes[mid].left = buildRange(first, mid);
+    nodes[mid].right = buildRange(mid + 1, last);
+    return updateNode(mid);
+}
+
+// ============ SEARCH OPERATION ============
 
-    return searchNode(node->right, code);
+const Driver* AVLTree::search(const string& code) const {
+    auto found = nodeByCode.find(code);
+    if (found == nodeByCode.end()) return nullptr;
+    return &driverOf(found->second);
 }
 
 // ============ TRAVERSAL OPERATIONS ============
 
-void AVLTree::inOrderTraversal(AVLNode* node, vector<Driver>& result) {
-    if (node == nullptr) return;
+void AVLTree::inOrderTraversal(uint32_t node, vector<Driver>& result) {
+    if (node == AVL_NIL) return;
 
-    inOrderTraversal(node->left, result);
-    result.push_back(node->driver);
-    inOrderTraversal(node->right, result);
+    inOrderTraversal(nodes[node].left, result);
+    result.push_back(driverOf(node));
+    inOrderTraversal(nodes[node].right, result);
 }
 
 
@@ -189,36 +318,188 @@ vector<Driver> AVLTree::getDriversByPointsDescending() {
 }
 
 
+// In-order walk that stops once n drivers are collected: O(log n + n)
+void AVLTree::collectTop(uint32_t node, int n, vector<Driver>& result) {
+    if (node == AVL_NIL || (int)result.size() >= n) return;
+
+    collectTop(nodes[node].left, n, result);
+    if ((int)result.size() < n) {
+        result.push_back(driverOf(node));
+    }
+    collectTop(nodes[node].right, n, result);
+}
+
 vector<Driver> AVLTree::getTopNDrivers(int n) {
-    vector<Driver> allDrivers = getDriversByPointsDescending();
     vector<Driver> topN;
+    if (n <= 0) return topN;
 
-    int count = n < allDrivers.size() ? n : allDrivers.size();
-    for (int i = 0; i < count; i++) {
-        topN.push_back(allDrivers[i]);
+    topN.reserve(n < size() ? n : size());
+    collectTop(root, n, topN);
+    return topN;
+}
+
+// ============ ITERATORS ============
+
+void AVLTree::Iterator::pushLeftmost(uint32_t node) {
+    while (node != AVL_NIL) {
+        path[depth++] = node;
+        node = tree->nodes[node].left;
     }
+}
 
-    return topN;
+void AVLTree::Iterator::pushRightmost(uint32_t node) {
+    while (node != AVL_NIL) {
+        path[depth++] = node;
+        node = tree->nodes[node].right;
+    }
 }
 
-// ============ UTILITY METHODS ============
+AVLTree::Iterator& AVLTree::Iterator::operator++() {
+    uint32_t right = tree->nodes[path[depth - 1]].right;
+    if (right != AVL_NIL) {
+        pushLeftmost(right);
+        return *this;
+    }
 
-int AVLTree::size() {
-    return countNodes(root);
+    // Climb until we leave a left subtree; climbing out of the root is end()
+    uint32_t child;
+    do {
+        child = path[--depth];
+    } while (depth > 0 && tree->nodes[path[depth - 1]].right == child);
+    return *this;
 }
 
-int AVLTree::countNodes(AVLNode* node) {
-    if (node == nullptr) return 0;
-    return 1 + countNodes(node->left) + countNodes(node->right);
+AVLTree::Iterator& AVLTree::Iterator::operator--() {
+    if (depth == 0) {
+        pushRightmost(tree->root);
+        return *this;
+    }
+
+    uint32_t left = tree->nodes[path[depth - 1]].left;
+    if (left != AVL_NIL) {
+        pushRightmost(left);
+        return *this;
+    }
+
+    uint32_t child;
+    do {
+        child = path[--depth];
+    } while (depth > 0 && tree->nodes[path[depth - 1]].left == child);
+    return *this;
+}
+
+AVLTree::Iterator AVLTree::begin() const {
+    Iterator it(this);
+    it.pushLeftmost(root);
+    return it;
+}
+
+AVLTree::Iterator AVLTree::end() const {
+    return Iterator(this);
+}
+
+// First node in ranking order with fewer than `points` (or at most, when
+// inclusive). The descent records its path, and the bound's path is a
+// prefix of it.
+AVLTree::Iterator AVLTree::firstBelow(int points, bool inclusive) const {
+    Iterator it(this);
+    int found = 0;
+    uint32_t node = root;
+    while (node != AVL_NIL) {
+        it.path[it.depth++] = node;
+        int nodePoints = nodes[node].points;
+        if (nodePoints < points || (inclusive && nodePoints == points)) {
+            found = it.depth;
+            node = nodes[node].left;
+        } else {
+            node = nodes[node].right;
+        }
+    }
+    it.depth = found;
+    return it;
+}
+
+AVLTree::DriverRange AVLTree::range(int minPoints, int maxPoints) const {
+    DriverRange result;
+    result.first = end();
+    result.last = end();
+    if (minPoints > maxPoints) return result;
+
+    result.first = firstBelow(maxPoints, true);
+    result.last = firstBelow(minPoints, false);
+    return result;
+}
+
+// ============ ORDER STATISTICS ============
+
+int AVLTree::getRank(int points, const string& code) {
+    int rank = 0;
+    uint32_t node = root;
+
+    // Same ordering as insert: more points first, then code. Codes are
+    // only read on ties.
+    while (node != AVL_NIL) {
+        const AVLNode& n = nodes[node];
+
+        bool before = points > n.points;
+        if (points == n.points) {
+            const string& nodeCode = driverOf(node).getCode();
+            if (code == nodeCode) {
+                return rank + getSize(n.left) + 1;
+            }
+            before = code < nodeCode;
+        }
+        if (before) {
+            node = n.left;
+        } else {
+            rank += getSize(n.left) + 1;
+            node = n.right;
+        }
+    }
+    return 0;
+}
+
+int AVLTree::getRank(const string& code) {
+    auto found = nodeByCode.find(code);
+    if (found == nodeByCode.end()) return 0;
+    return getRank(nodes[found->second].points, code);
+}
+
+const Driver* AVLTree::getKthDriver(int k) {
+    if (k < 1 || k > size()) return nullptr;
+
+    uint32_t node = root;
+    while (node != AVL_NIL) {
+        int leftSize = getSize(nodes[node].left);
+        if (k == leftSize + 1) {
+            return &driverOf(node);
+        }
+        if (k <= leftSize) {
+            node = nodes[node].left;
+        } else {
+            k -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+    return nullptr;
+}
+
+// ============ UTILITY METHODS ============
+
+int AVLTree::size() {
+    return getSize(root);
 }
 
 bool AVLTree::isEmpty() {
-    return root == nullptr;
+    return root == AVL_NIL;
 }
 
 void AVLTree::clear() {
-    destroyTree(root);
-    root = nullptr;
+    nodes.clear();
+    nodeOfDriver.clear();
+    nodeByCode.clear();
+    root = AVL_NIL;
+    freeHead = AVL_NIL;
 }
 
 // ============ DISPLAY METHODS ============
@@ -230,19 +511,18 @@ void AVLTree::displayRankings() {
         return;
     }
 
-    vector<Driver> drivers = getDriversByPointsDescending();
-
     cout << "\n=== DRIVER RANKINGS (AVL Tree) ===" << endl;
     cout << "Rank | Code | Name                | Team           | Points | Price" << endl;
     cout << "--------------------------------------------------------------------" << endl;
 
-    for (int i = 0; i < drivers.size(); i++) {
-        cout << setw(4) << (i + 1) << " | "
-             << setw(4) << drivers[i].getCode() << " | "
-             << setw(19) << left << drivers[i].getName() << " | "
-             << setw(14) << drivers[i].getTeam() << " | "
-             << setw(6) << right << drivers[i].getPoints() << " | "
-             << setw(5) << drivers[i].getPrice() << "M" << endl;
+    int rank = 1;
+    for (const Driver& driver : *this) {
+        cout << setw(4) << rank++ << " | "
+             << setw(4) << driver.getCode() << " | "
+             << setw(19) << left << driver.getName() << " | "
+             << setw(14) << driver.getTeam() << " | "
+             << setw(6) << right << driver.getPoints() << " | "
+             << setw(5) << driver.getPrice() << "M" << endl;
     }
     cout << endl;
 }
\ No newline at end of file
@@ -7,67 +7,193 @@
 #define F1_FANTASY_DSA_AVLTREE_H
 
 #include "../Core/Driver.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 using namespace std;
 
-// AVL Tree Node structure
+// Null child index
+const uint32_t AVL_NIL = 0xFFFFFFFF;
+
+// An AVL tree of 2^32 nodes is at most 46 levels deep
+const int AVL_MAX_DEPTH = 48;
+
+// AVL Tree Node structure. Nodes live in one pool and link by index, and
+// carry only the sort key and a driver id, so walks never touch driver
+// strings except to break ties.
 struct AVLNode {
-    Driver driver;
-    AVLNode* left;
-    AVLNode* right;
+    int points;         // Sort key, as of the driver's last insert or update
+    uint32_t driverId;  // Index into the caller's drivers
+    uint32_t left;
+    uint32_t right;
     int height;
+    int size;           // Nodes in this subtree, for rank queries
 
     // Constructor
-    AVLNode(const Driver& d) : driver(d), left(nullptr), right(nullptr), height(1) {}
+    AVLNode(int p, uint32_t id) : points(p), driverId(id), left(AVL_NIL), right(AVL_NIL), height(1), size(1) {}
 };
 
 class AVLTree {
 private:
-    AVLNode* root;
+    // The drivers stay in the caller's vector and the tree holds only their
+    // ids (indices into it), so the vector must not be resized or reordered
+    // while the tree uses it
+    const vector<Driver>& drivers;
+
+    uint32_t root;
+
+    // Node pool. Freed nodes are chained through `left` and reused before
+    // the pool grows.
+    vector<AVLNode> nodes;
+    uint32_t freeHead;
+
+    // Node of each driver id, AVL_NIL if that driver isn't in the tree
+    vector<uint32_t> nodeOfDriver;
+
+    // Secondary index: the tree is ordered by points, so code lookups go
+    // here. Keys view the caller's code strings rather than copying them.
+    // Rotations relink nodes without moving them, so entries only change
+    // on insert, delete and clear. Codes are unique per tree.
+    unordered_map<string_view, uint32_t> nodeByCode;
+
+    // Pool management
+    uint32_t allocateNode(uint32_t id);
+    void freeNode(uint32_t node);
+    const Driver& driverOf(uint32_t node) const { return drivers[nodes[node].driverId]; }
 
     // Helper functions
-    int getHeight(AVLNode* node);
-    int getBalanceFactor(AVLNode* node);
-    AVLNode* updateHeight(AVLNode* node);
+    int getHeight(uint32_t node) const;
+    int getSize(uint32_t node) const;
+    int getBalanceFactor(uint32_t node) const;
+    uint32_t updateNode(uint32_t node);  // Height and subtree size
 
     // Rotation functions
-    AVLNode* rotateRight(AVLNode* y);
-    AVLNode* rotateLeft(AVLNode* x);
-
-    // Insert helper
-    AVLNode* insertNode(AVLNode* node, const Driver& driver);
+    uint32_t rotateRight(uint32_t y);
+    uint32_t rotateLeft(uint32_t x);
 
-    // Traversal helpers
-    void inOrderTraversal(AVLNode* node, vector<Driver>& result);
-    void reverseInOrderTraversal(AVLNode* node, vector<Driver>& result);
+    // Balancing helpers
+    bool comesBefore(uint32_t a, uint32_t b) const;
+    uint32_t rebalance(uint32_t node);
 
-    // Search helpers
-    AVLNode* searchNode(AVLNode* node, const string& code);
+    // Insert and delete helpers; both move whole nodes
+    uint32_t linkNode(uint32_t node, uint32_t fresh);
+    uint32_t detachNode(uint32_t node, uint32_t target);
+    uint32_t detachMin(uint32_t node, uint32_t& minNode);
+    uint32_t buildRange(uint32_t first, uint32_t last);
 
-    // Utility
-    void destroyTree(AVLNode* node);
-    int countNodes(AVLNode* node);
+    // Traversal helpers
+    void inOrderTraversal(uint32_t node, vector<Driver>& result);
+    void reverseInOrderTraversal(uint32_t node, vector<Driver>& result);
+    void collectTop(uint32_t node, int n, vector<Driver>& result);
 
     // Display helper
-    void displayTree(AVLNode* node, int indent, bool isRight);
+    void displayTree(uint32_t node, int indent, bool isRight);
 
 public:
-    // Constructor and Destructor
-    AVLTree();
-    ~AVLTree();
+    // In-order (ranking order) walk over the stored drivers. Nodes have no
+    // parent links, so the iterator carries its root-to-node path. Any
+    // change to the tree invalidates it.
+    class Iterator {
+    private:
+        friend class AVLTree;
+
+        const AVLTree* tree;
+        uint32_t path[AVL_MAX_DEPTH];
+        int depth;  // 0 = end
+
+        explicit Iterator(const AVLTree* t) : tree(t), depth(0) {}
+        void pushLeftmost(uint32_t node);
+        void pushRightmost(uint32_t node);
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = Driver;
+        using difference_type = ptrdiff_t;
+        using pointer = const Driver*;
+        using reference = const Driver&;
+
+        Iterator() : tree(nullptr), depth(0) {}
+
+        const Driver& operator*() const {
+            return tree->driverOf(path[depth - 1]);
+        }
+        const Driver* operator->() const { return &**this; }
+
+        Iterator& operator++();
+        Iterator& operator--();  // From end() moves to the last driver
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+
+        bool operator==(const Iterator& other) const {
+            return depth == other.depth && (depth == 0 || path[depth - 1] == other.path[depth - 1]);
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    // A [first, last) slice of the ranking, usable in range-for
+    struct DriverRange {
+        Iterator first;
+        Iterator last;
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+private:
+    // Range bound helper; needs Iterator, hence declared down here
+    Iterator firstBelow(int points, bool inclusive) const;
 
-    // Main operations
-    void insert(const Driver& driver);
-    Driver* search(const string& code);
+public:
+    // Constructor; starts empty
+    explicit AVLTree(const vector<Driver>& drivers);
+
+    // Main operations, O(log n). Drivers are named by id, their index in
+    // the constructor's vector; ids out of range are ignored.
+    void insert(uint32_t id);  // Same as update if the driver is in the tree
+    bool remove(uint32_t id);
+    // Moves the driver to match its current points, after they changed;
+    // false if the driver isn't in the tree
+    bool update(uint32_t id);
+    const Driver* search(const string& code) const;  // O(1)
+
+    // Replaces the contents with driver ids already in ranking order,
+    // building a perfectly balanced tree in O(n). Input out of order or
+    // with a repeated driver falls back to inserting one at a time.
+    void buildFromSorted(const vector<uint32_t>& sortedIds);
+    // Sorts every driver into ranking order, then builds from that
+    void rebuild();
+
+    // Ranking order: more points first, then code. Sort with this before
+    // calling buildFromSorted.
+    static bool ranksAhead(const Driver& a, const Driver& b);
 
     // Traversal methods
     vector<Driver> getDriversByPointsDescending();
     vector<Driver> getDriversByPointsAscending();
-    vector<Driver> getTopNDrivers(int n);
+    vector<Driver> getTopNDrivers(int n);  // Visits only the first n
+
+    // Iteration without copying, most points first; iterate in reverse
+    // for ascending order
+    Iterator begin() const;
+    Iterator end() const;
+
+    // Drivers with minPoints <= points <= maxPoints, in ranking order.
+    // Both ends are found in O(log n), so iterating costs only the matches.
+    DriverRange range(int minPoints, int maxPoints) const;
+
+    // Order statistics, 1-based in ranking order (most points first), by
+    // the points the tree last saw
+    int getRank(int points, const string& code);  // 0 if not in the tree
+    int getRank(const string& code);
+    const Driver* getKthDriver(int k);            // nullptr if out of range
 
     // Utility methods
-    int size();
+    int size();  // O(1)
     bool isEmpty();
     void clear();
 